@@ -9,7 +9,7 @@
 #include "device_launch_parameters.h"
 
 #include "../../Utils/data_types_common.h"
-#include "../../Utils/sort_interface.h"
+#include "../../Utils/sort_interface_parallel.h"
 #include "../../Utils/host.h"
 #include "../constants.h"
 
@@ -8,6 +8,7 @@
 #include "../../Utils/data_types_common.h"
 #include "../../Utils/sort_interface.h"
 #include "../../Utils/host.h"
+#include "../../Utils/trace.h"
 
 
 /*
@@ -26,6 +27,8 @@ protected:
     {
         for (uint_t subBlockSize = 1; subBlockSize < arrayLength; subBlockSize <<= 1)
         {
+            TRACE_SCOPE_ARG("bitonic phase", "sub block size", subBlockSize);
+
             for (uint_t stride = subBlockSize; stride > 0; stride >>= 1)
             {
                 bool isFirstStepOfPhase = stride == subBlockSize;
@@ -105,6 +108,20 @@ public:
     {
         return this->_sortName;
     }
+
+    /*
+    Every step of every phase reads and writes keys and values once. Array of length "2^L" is sorted in "L" phases
+    with "L * (L + 1) / 2" steps. Steps are executed from main memory, unless array fits into last level cache.
+    */
+    double getBytesMoved()
+    {
+        double numPhases = _arrayLength > 1 ? log2((double)nextPowerOf2(_arrayLength)) : 0;
+        double numSteps = numPhases * (numPhases + 1) / 2;
+        double numMemorySteps = getNumMemoryLevels(numSteps, 1, getElementSize());
+
+        return getBytesOfPasses(2 * numMemorySteps, 2 * numMemorySteps) +
+            getBytesOfCacheLevels(numSteps, numMemorySteps);
+    }
 };
 
 #endif
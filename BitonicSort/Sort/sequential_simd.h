@@ -0,0 +1,461 @@
+#ifndef BITONIC_SORT_SEQUENTIAL_SIMD_H
+#define BITONIC_SORT_SEQUENTIAL_SIMD_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "../../Utils/data_types_common.h"
+#include "../../Utils/sort_interface.h"
+#include "../../Utils/host.h"
+#include "../../Utils/simd.h"
+#include "../../Utils/trace.h"
+#include "../data_types.h"
+
+
+/*
+Class for sequential bitonic sort with vector instructions (AVX-512 or AVX2, chosen at compile time).
+
+Performs the same NORMALIZED bitonic sort as "BitonicSortSequential". Steps with stride lower than vector width
+are performed inside registers with networks of permutations and min/max operations. All steps with stride lower
+than vector width are executed in one pass over array. Steps with bigger strides compare-exchange whole vectors.
+In key-value sort values are carried through the same masks as keys.
+*/
+class BitonicSortSequentialSimd : public SortSequential
+{
+protected:
+    std::string _sortName = "Bitonic sort sequential SIMD";
+
+    /*
+    Compare-exchanges two elements.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly>
+    inline void compareExchange(data_t *h_keys, data_t *h_values, uint_t indexLeft, uint_t indexRight)
+    {
+        data_t keyLeft = h_keys[indexLeft];
+        data_t keyRight = h_keys[indexRight];
+
+        if (sortOrder == ORDER_ASC ? keyLeft > keyRight : keyLeft < keyRight)
+        {
+            h_keys[indexLeft] = keyRight;
+            h_keys[indexRight] = keyLeft;
+
+            if (!sortingKeyOnly)
+            {
+                data_t temp = h_values[indexLeft];
+                h_values[indexLeft] = h_values[indexRight];
+                h_values[indexRight] = temp;
+            }
+        }
+    }
+
+    /*
+    Compare-exchanges all lanes of two vectors.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly>
+    inline void compareExchangeSimd(simd_t &keysLeft, simd_t &keysRight, simd_t &valuesLeft, simd_t &valuesRight)
+    {
+        if (sortingKeyOnly)
+        {
+            simd_t keysMin = simdMin(keysLeft, keysRight);
+            simd_t keysMax = simdMax(keysLeft, keysRight);
+
+            keysLeft = sortOrder == ORDER_ASC ? keysMin : keysMax;
+            keysRight = sortOrder == ORDER_ASC ? keysMax : keysMin;
+        }
+        else
+        {
+            simd_mask_t swap = sortOrder == ORDER_ASC ? simdGreater(keysLeft, keysRight) : simdGreater(
+                keysRight, keysLeft
+            );
+            simd_t temp = simdBlend(keysLeft, keysRight, swap);
+
+            keysRight = simdBlend(keysRight, keysLeft, swap);
+            keysLeft = temp;
+            temp = simdBlend(valuesLeft, valuesRight, swap);
+            valuesRight = simdBlend(valuesRight, valuesLeft, swap);
+            valuesLeft = temp;
+        }
+    }
+
+    /*
+    Compare-exchanges lanes of vector with lanes of the same vector. Lane "i" is compared with lane given by
+    permutation. Lanes in "upperLanes" are right elements of compare-exchange pairs.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly>
+    inline void compareExchangeLanes(simd_t &keys, simd_t &values, simd_t permutation, simd_mask_t upperLanes)
+    {
+        simd_t keysPartner = simdPermute(keys, permutation);
+
+        if (sortingKeyOnly)
+        {
+            simd_t keysMin = simdMin(keys, keysPartner);
+            simd_t keysMax = simdMax(keys, keysPartner);
+
+            if (sortOrder == ORDER_ASC)
+            {
+                keys = simdBlend(keysMin, keysMax, upperLanes);
+            }
+            else
+            {
+                keys = simdBlend(keysMax, keysMin, upperLanes);
+            }
+        }
+        else
+        {
+            simd_t valuesPartner = simdPermute(values, permutation);
+            simd_mask_t greater = simdGreater(keys, keysPartner);
+            simd_mask_t lower = simdGreater(keysPartner, keys);
+            simd_mask_t swap;
+
+            if (sortOrder == ORDER_ASC)
+            {
+                swap = simdBlendMask(greater, lower, upperLanes);
+            }
+            else
+            {
+                swap = simdBlendMask(lower, greater, upperLanes);
+            }
+
+            keys = simdBlend(keys, keysPartner, swap);
+            values = simdBlend(values, valuesPartner, swap);
+        }
+    }
+
+    /*
+    Creates in-register step, which compare-exchanges every lane "i" with lane "i ^ laneXor". If "laneXor" is
+    "2 * stride - 1", then step is the first step of phase in normalized bitonic sort.
+    */
+    void createStepSimd(uint_t laneXor, uint_t stride, simd_t *permutation, simd_mask_t *upperLanes)
+    {
+        uint_t laneIndexes[SIMD_WIDTH];
+        uint_t laneFlags[SIMD_WIDTH];
+
+        for (uint_t lane = 0; lane < SIMD_WIDTH; lane++)
+        {
+            laneIndexes[lane] = lane ^ laneXor;
+            laneFlags[lane] = lane & stride;
+        }
+
+        *permutation = simdPermutation(laneIndexes);
+        *upperLanes = simdLaneMask(laneFlags);
+    }
+
+    /*
+    Executes provided in-register steps on every vector of array. Last vector, which is only partially filled
+    with array elements, is padded with values, which are never exchanged with array elements.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly>
+    void executeStepsSimd(
+        data_t *h_keys, data_t *h_values, simd_t *permutations, simd_mask_t *upperLanes, uint_t numSteps,
+        uint_t arrayLength
+    )
+    {
+        if (numSteps == 0)
+        {
+            return;
+        }
+
+        simd_t keys, values;
+        uint_t index = 0;
+
+        for (; index + SIMD_WIDTH <= arrayLength; index += SIMD_WIDTH)
+        {
+            keys = simdLoad(h_keys + index);
+            values = sortingKeyOnly ? keys : simdLoad(h_values + index);
+
+            for (uint_t step = 0; step < numSteps; step++)
+            {
+                compareExchangeLanes<sortOrder, sortingKeyOnly>(keys, values, permutations[step], upperLanes[step]);
+            }
+
+            simdStore(h_keys + index, keys);
+            if (!sortingKeyOnly)
+            {
+                simdStore(h_values + index, values);
+            }
+        }
+
+        if (index == arrayLength)
+        {
+            return;
+        }
+
+        data_t keysPadded[SIMD_WIDTH], valuesPadded[SIMD_WIDTH];
+        for (uint_t lane = 0; lane < SIMD_WIDTH; lane++)
+        {
+            bool isPadding = index + lane >= arrayLength;
+            keysPadded[lane] = isPadding ? (sortOrder == ORDER_ASC ? MAX_VAL : MIN_VAL) : h_keys[index + lane];
+            valuesPadded[lane] = isPadding || sortingKeyOnly ? 0 : h_values[index + lane];
+        }
+
+        keys = simdLoad(keysPadded);
+        values = simdLoad(valuesPadded);
+        for (uint_t step = 0; step < numSteps; step++)
+        {
+            compareExchangeLanes<sortOrder, sortingKeyOnly>(keys, values, permutations[step], upperLanes[step]);
+        }
+        simdStore(keysPadded, keys);
+        simdStore(valuesPadded, values);
+
+        for (uint_t lane = 0; index + lane < arrayLength; lane++)
+        {
+            h_keys[index + lane] = keysPadded[lane];
+            if (!sortingKeyOnly)
+            {
+                h_values[index + lane] = valuesPadded[lane];
+            }
+        }
+    }
+
+    /*
+    Executes the first step of phase on interval "[jStart, jEnd)" of one block, when stride is greater or equal
+    than vector width. Element "j" of block is compare-exchanged with element "2 * stride - 1 - j", so right
+    vectors are reversed.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly>
+    void bitonicFirstStepBlockSimd(
+        data_t *h_keys, data_t *h_values, simd_t reversePermutation, uint_t stride, uint_t blockStart,
+        uint_t jStart, uint_t jEnd, uint_t arrayLength
+    )
+    {
+        simd_t keysLeft, keysRight, valuesLeft, valuesRight;
+        uint_t blockEnd = blockStart + 2 * stride;
+        // Elements, which don't have a pair inside array, are skipped
+        uint_t j = max(jStart, blockEnd > arrayLength ? blockEnd - arrayLength : 0);
+
+        for (; j + SIMD_WIDTH <= jEnd; j += SIMD_WIDTH)
+        {
+            uint_t indexLeft = blockStart + j;
+            uint_t indexRight = blockEnd - SIMD_WIDTH - j;
+
+            keysLeft = simdLoad(h_keys + indexLeft);
+            keysRight = simdPermute(simdLoad(h_keys + indexRight), reversePermutation);
+            if (!sortingKeyOnly)
+            {
+                valuesLeft = simdLoad(h_values + indexLeft);
+                valuesRight = simdPermute(simdLoad(h_values + indexRight), reversePermutation);
+            }
+
+            compareExchangeSimd<sortOrder, sortingKeyOnly>(keysLeft, keysRight, valuesLeft, valuesRight);
+
+            simdStore(h_keys + indexLeft, keysLeft);
+            simdStore(h_keys + indexRight, simdPermute(keysRight, reversePermutation));
+            if (!sortingKeyOnly)
+            {
+                simdStore(h_values + indexLeft, valuesLeft);
+                simdStore(h_values + indexRight, simdPermute(valuesRight, reversePermutation));
+            }
+        }
+
+        for (; j < jEnd; j++)
+        {
+            compareExchange<sortOrder, sortingKeyOnly>(h_keys, h_values, blockStart + j, blockEnd - 1 - j);
+        }
+    }
+
+    /*
+    Executes the first step of phase, when stride is greater or equal than vector width.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly>
+    void bitonicFirstStepSimd(
+        data_t *h_keys, data_t *h_values, simd_t reversePermutation, uint_t stride, uint_t arrayLength
+    )
+    {
+        for (uint_t blockStart = 0; blockStart + stride < arrayLength; blockStart += 2 * stride)
+        {
+            bitonicFirstStepBlockSimd<sortOrder, sortingKeyOnly>(
+                h_keys, h_values, reversePermutation, stride, blockStart, 0, stride, arrayLength
+            );
+        }
+    }
+
+    /*
+    Executes step of bitonic merge, when stride is greater or equal than vector width.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly>
+    void bitonicMergeStepSimd(data_t *h_keys, data_t *h_values, uint_t stride, uint_t arrayLength)
+    {
+        simd_t keysLeft, keysRight, valuesLeft, valuesRight;
+
+        for (uint_t blockStart = 0; blockStart + stride < arrayLength; blockStart += 2 * stride)
+        {
+            uint_t indexEnd = min(blockStart + stride, arrayLength - stride);
+            uint_t index = blockStart;
+
+            for (; index + SIMD_WIDTH <= indexEnd; index += SIMD_WIDTH)
+            {
+                keysLeft = simdLoad(h_keys + index);
+                keysRight = simdLoad(h_keys + index + stride);
+                if (!sortingKeyOnly)
+                {
+                    valuesLeft = simdLoad(h_values + index);
+                    valuesRight = simdLoad(h_values + index + stride);
+                }
+
+                compareExchangeSimd<sortOrder, sortingKeyOnly>(keysLeft, keysRight, valuesLeft, valuesRight);
+
+                simdStore(h_keys + index, keysLeft);
+                simdStore(h_keys + index + stride, keysRight);
+                if (!sortingKeyOnly)
+                {
+                    simdStore(h_values + index, valuesLeft);
+                    simdStore(h_values + index + stride, valuesRight);
+                }
+            }
+
+            for (; index < indexEnd; index++)
+            {
+                compareExchange<sortOrder, sortingKeyOnly>(h_keys, h_values, index, index + stride);
+            }
+        }
+    }
+
+    /*
+    Creates in-register networks needed to sort and merge vectors.
+    */
+    void createNetworkSimd(simd_network_t *network)
+    {
+        uint_t laneIndexes[SIMD_WIDTH];
+
+        network->numSortSteps = 0;
+        for (uint_t subBlockSize = 1; subBlockSize < SIMD_WIDTH; subBlockSize <<= 1)
+        {
+            createStepSimd(
+                2 * subBlockSize - 1, subBlockSize, &network->sortPermutations[network->numSortSteps],
+                &network->sortUpperLanes[network->numSortSteps]
+            );
+            network->numSortSteps++;
+
+            for (uint_t stride = subBlockSize / 2; stride > 0; stride >>= 1)
+            {
+                createStepSimd(
+                    stride, stride, &network->sortPermutations[network->numSortSteps],
+                    &network->sortUpperLanes[network->numSortSteps]
+                );
+                network->numSortSteps++;
+            }
+        }
+
+        network->numMergeSteps = 0;
+        for (uint_t stride = SIMD_WIDTH / 2; stride > 0; stride >>= 1)
+        {
+            createStepSimd(
+                stride, stride, &network->mergePermutations[network->numMergeSteps],
+                &network->mergeUpperLanes[network->numMergeSteps]
+            );
+            network->numMergeSteps++;
+        }
+
+        for (uint_t lane = 0; lane < SIMD_WIDTH; lane++)
+        {
+            laneIndexes[lane] = SIMD_WIDTH - 1 - lane;
+        }
+        network->reversePermutation = simdPermutation(laneIndexes);
+    }
+
+    /*
+    Sorts data sequentially with NORMALIZED bitonic sort using vector instructions and provided networks.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly>
+    void bitonicSortBlockSimd(data_t *h_keys, data_t *h_values, simd_network_t *network, uint_t arrayLength)
+    {
+        // All phases with sub-block size lower than vector width are executed inside registers
+        executeStepsSimd<sortOrder, sortingKeyOnly>(
+            h_keys, h_values, network->sortPermutations, network->sortUpperLanes, network->numSortSteps,
+            arrayLength
+        );
+
+        for (uint_t subBlockSize = SIMD_WIDTH; subBlockSize < arrayLength; subBlockSize <<= 1)
+        {
+            TRACE_SCOPE_SIZED("bitonic phase", "sub block size", subBlockSize, arrayLength);
+
+            bitonicFirstStepSimd<sortOrder, sortingKeyOnly>(
+                h_keys, h_values, network->reversePermutation, subBlockSize, arrayLength
+            );
+
+            for (uint_t stride = subBlockSize / 2; stride >= SIMD_WIDTH; stride >>= 1)
+            {
+                bitonicMergeStepSimd<sortOrder, sortingKeyOnly>(h_keys, h_values, stride, arrayLength);
+            }
+
+            // Steps with stride lower than vector width are executed inside registers
+            executeStepsSimd<sortOrder, sortingKeyOnly>(
+                h_keys, h_values, network->mergePermutations, network->mergeUpperLanes, network->numMergeSteps,
+                arrayLength
+            );
+        }
+    }
+
+    /*
+    Sorts data sequentially with NORMALIZED bitonic sort using vector instructions.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly>
+    void bitonicSortSequentialSimd(data_t *h_keys, data_t *h_values, uint_t arrayLength)
+    {
+        simd_network_t network;
+
+        createNetworkSimd(&network);
+        bitonicSortBlockSimd<sortOrder, sortingKeyOnly>(h_keys, h_values, &network, arrayLength);
+    }
+
+    /*
+    Wrapper for bitonic sort method.
+    The code runs faster if arguments are passed to method. If members are accessed directly, code runs slower.
+    */
+    void sortKeyOnly()
+    {
+        if (_sortOrder == ORDER_ASC)
+        {
+            bitonicSortSequentialSimd<ORDER_ASC, true>(_h_keys, NULL, _arrayLength);
+        }
+        else
+        {
+            bitonicSortSequentialSimd<ORDER_DESC, true>(_h_keys, NULL, _arrayLength);
+        }
+    }
+
+    /*
+    Wrapper for bitonic sort method.
+    The code runs faster if arguments are passed to method. If members are accessed directly, code runs slower.
+    */
+    void sortKeyValue()
+    {
+        if (_sortOrder == ORDER_ASC)
+        {
+            bitonicSortSequentialSimd<ORDER_ASC, false>(_h_keys, _h_values, _arrayLength);
+        }
+        else
+        {
+            bitonicSortSequentialSimd<ORDER_DESC, false>(_h_keys, _h_values, _arrayLength);
+        }
+    }
+
+public:
+    std::string getSortName()
+    {
+        return this->_sortName;
+    }
+
+    /*
+    Every pass over array reads and writes keys and values once. Steps with stride lower than vector width are
+    executed in one pass, steps with greater stride are executed in one pass per step. Passes are executed from
+    main memory, unless array fits into last level cache.
+    */
+    double getBytesMoved()
+    {
+        double numPasses = 1;
+
+        for (uint_t subBlockSize = SIMD_WIDTH; subBlockSize < _arrayLength; subBlockSize <<= 1)
+        {
+            // First step, steps with stride from "subBlockSize / 2" to vector width and steps inside registers
+            numPasses += 2 + log2((double)subBlockSize / SIMD_WIDTH);
+        }
+
+        double numMemoryPasses = getNumMemoryLevels(numPasses, 1, getElementSize());
+        return getBytesOfPasses(2 * numMemoryPasses, 2 * numMemoryPasses) +
+            getBytesOfCacheLevels(numPasses, numMemoryPasses);
+    }
+};
+
+#endif
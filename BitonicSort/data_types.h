@@ -0,0 +1,32 @@
+#ifndef DATA_TYPES_BITONIC_SORT_H
+#define DATA_TYPES_BITONIC_SORT_H
+
+#include <stdint.h>
+
+#include "../Utils/data_types_common.h"
+#include "../Utils/simd.h"
+
+
+typedef struct SimdNetwork simd_network_t;
+
+/*
+In-register networks of compare-exchange steps needed for bitonic sort with vector instructions. Every step is
+represented with permutation, which gives the partner of every lane, and with mask of lanes, which are right
+elements of compare-exchange pairs. Number of steps needed to sort one vector is "log(W) * (log(W) + 1) / 2" and
+number of steps needed to merge one vector is "log(W)", which is never greater than vector width "W".
+*/
+struct SimdNetwork
+{
+    simd_t sortPermutations[SIMD_WIDTH];
+    simd_mask_t sortUpperLanes[SIMD_WIDTH];
+    uint_t numSortSteps;
+
+    simd_t mergePermutations[SIMD_WIDTH];
+    simd_mask_t mergeUpperLanes[SIMD_WIDTH];
+    uint_t numMergeSteps;
+
+    // Reverses the order of lanes
+    simd_t reversePermutation;
+};
+
+#endif
@@ -0,0 +1,216 @@
+#ifndef BITONIC_SORT_ADAPTIVE_MULTITHREADED_H
+#define BITONIC_SORT_ADAPTIVE_MULTITHREADED_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <atomic>
+#include <vector>
+#include <functional>
+
+#include "../../Utils/data_types_common.h"
+#include "../../Utils/threads.h"
+#include "../../Utils/host.h"
+#include "../../Utils/trace.h"
+#include "../data_types.h"
+#include "../constants.h"
+#include "sequential.h"
+
+
+/*
+Base class for multithreaded adaptive bitonic sort.
+Needed for template specialization.
+
+Subtrees of bitonic tree, which are sorted or merged independently from each other, are executed as tasks. Tasks
+are distributed among threads dynamically. Subtrees on lower levels are sorted sequentially. On higher levels merge
+phases are executed level by level (one merge phase splits one merge into two independent merges), until there are
+enough merges for all threads. Remaining merges are executed sequentially.
+
+Template params:
+sequentialCutoff - subtrees with this many nodes or less are sorted and merged sequentially
+tasksPerThread - minimal number of tasks per thread
+*/
+template <uint_t sequentialCutoff, uint_t tasksPerThread>
+class BitonicSortAdaptiveMultithreadedBase : public BitonicSortAdaptiveSequential
+{
+    static_assert(sequentialCutoff >= 2, "Sequential cutoff in adaptive bitonic sort has to be at least 2.");
+
+protected:
+    std::string _sortName = "Bitonic sort adaptive multithreaded";
+
+    /*
+    Executes provided task for all subtrees. Subtrees are distributed among threads dynamically.
+    */
+    void executeTasks(
+        std::vector<subtree_t> &subtrees, uint_t numThreads, std::function<void(subtree_t subtree)> task
+    )
+    {
+        std::atomic<uint_t> taskCounter(0);
+
+        parallelFor(numThreads, [&](uint_t) {
+            TRACE_SCOPE("adaptive bitonic tasks");
+            uint_t i;
+
+            while ((i = taskCounter++) < subtrees.size())
+            {
+                task(subtrees[i]);
+            }
+        });
+    }
+
+    /*
+    Creates subtrees, which are children of provided subtrees. If "isMerge" is false, left child is sorted in
+    opposite order than its parent (needed for bitonic sequence), otherwise it is merged in the same order as
+    parent. Right child is always sorted or merged in the same order as parent.
+    If root is virtual, its right subtree contains only virtual nodes, so only the left child is created. It is
+    sorted in the same order as parent, same as in sequential sort.
+    */
+    std::vector<subtree_t> splitSubtrees(
+        node_t *nodes, std::vector<subtree_t> &subtrees, bool isMerge, uint_t arrayLength
+    )
+    {
+        std::vector<subtree_t> children;
+        children.reserve(2 * subtrees.size());
+
+        for (uint_t i = 0; i < subtrees.size(); i++)
+        {
+            subtree_t subtree = subtrees[i];
+            uint_t left = getLeftChild(nodes, subtree.root, arrayLength);
+
+            if (subtree.root >= arrayLength)
+            {
+                children.push_back({ left, subtree.root, subtree.sortOrder });
+                continue;
+            }
+
+            children.push_back({ left, subtree.root, isMerge ? subtree.sortOrder : (order_t)!subtree.sortOrder });
+            children.push_back({ nodes[subtree.root].right, subtree.spare, subtree.sortOrder });
+        }
+
+        return children;
+    }
+
+    /*
+    Merges all provided subtrees in parallel. Every subtree contains "subtreeSize" nodes (including spare node).
+    */
+    void bitonicMergeMultithreaded(
+        node_t *nodes, std::vector<subtree_t> merges, uint_t subtreeSize, uint_t numThreads, uint_t arrayLength
+    )
+    {
+        // Merge phases are executed, until there are enough independent merges for all threads
+        while (merges.size() < numThreads * tasksPerThread && subtreeSize > sequentialCutoff)
+        {
+            executeTasks(merges, numThreads, [&](subtree_t merge) {
+                if (merge.sortOrder == ORDER_ASC)
+                {
+                    bitonicMergePhase<ORDER_ASC>(nodes, merge.root, merge.spare, arrayLength);
+                }
+                else
+                {
+                    bitonicMergePhase<ORDER_DESC>(nodes, merge.root, merge.spare, arrayLength);
+                }
+            });
+
+            merges = splitSubtrees(nodes, merges, true, arrayLength);
+            subtreeSize /= 2;
+        }
+
+        executeTasks(merges, numThreads, [&](subtree_t merge) {
+            if (merge.sortOrder == ORDER_ASC)
+            {
+                bitonicMerge<ORDER_ASC>(nodes, merge.root, merge.spare, arrayLength);
+            }
+            else
+            {
+                bitonicMerge<ORDER_DESC>(nodes, merge.root, merge.spare, arrayLength);
+            }
+        });
+    }
+
+    /*
+    Sorts bitonic tree with multithreaded adaptive bitonic sort.
+    */
+    void bitonicSortAdaptiveMultithreaded(
+        node_t *nodes, order_t sortOrder, uint_t numThreads, uint_t treeLength, uint_t arrayLength
+    )
+    {
+        // Subtrees of bitonic tree on every level, which is sorted in parallel
+        std::vector<std::vector<subtree_t>> levels;
+        levels.push_back({ { treeLength / 2 - 1, treeLength - 1, sortOrder } });
+        uint_t subtreeSize = treeLength;
+
+        while (levels.back().size() < numThreads * tasksPerThread && subtreeSize > sequentialCutoff)
+        {
+            levels.push_back(splitSubtrees(nodes, levels.back(), false, arrayLength));
+            subtreeSize /= 2;
+        }
+
+        // Subtrees on the lowest level are sorted sequentially
+        {
+            TRACE_SCOPE("adaptive bitonic subtree sort");
+            executeTasks(levels.back(), numThreads, [&](subtree_t subtree) {
+                if (subtree.sortOrder == ORDER_ASC)
+                {
+                    bitonicSortAdaptiveSequential<ORDER_ASC>(nodes, subtree.root, subtree.spare, arrayLength);
+                }
+                else
+                {
+                    bitonicSortAdaptiveSequential<ORDER_DESC>(nodes, subtree.root, subtree.spare, arrayLength);
+                }
+            });
+        }
+
+        // Sorted subtrees are merged level by level. Roots of subtrees don't change during merges on lower levels.
+        // Subtrees with virtual root don't have to be merged, because their left subtree is already sorted.
+        for (int_t level = (int_t)levels.size() - 2; level >= 0; level--)
+        {
+            TRACE_SCOPE_ARG("adaptive bitonic merge level", "level", level);
+            std::vector<subtree_t> merges;
+            subtreeSize *= 2;
+
+            for (uint_t i = 0; i < levels[level].size(); i++)
+            {
+                if (levels[level][i].root < arrayLength)
+                {
+                    merges.push_back(levels[level][i]);
+                }
+            }
+
+            bitonicMergeMultithreaded(nodes, merges, subtreeSize, numThreads, arrayLength);
+        }
+    }
+
+    /*
+    Wrapper for multithreaded adaptive bitonic sort method.
+    The code runs faster if arguments are passed to method. If members are accessed directly, code runs slower.
+    */
+    void sortKeyOnly()
+    {
+        bitonicSortAdaptiveMultithreaded(
+            _nodes, _sortOrder, getNumThreads(), getBitonicTreeLength(_arrayLength), _arrayLength
+        );
+    }
+
+    /*
+    Wrapper for multithreaded adaptive bitonic sort method.
+    */
+    void sortKeyValue()
+    {
+        sortKeyOnly();
+    }
+
+public:
+    std::string getSortName()
+    {
+        return this->_sortName;
+    }
+};
+
+/*
+Class for multithreaded adaptive bitonic sort.
+*/
+class BitonicSortAdaptiveMultithreaded : public BitonicSortAdaptiveMultithreadedBase<
+    SEQUENTIAL_CUTOFF_MULTITHREADED, TASKS_PER_THREAD_MULTITHREADED
+>
+{};
+
+#endif
@@ -10,7 +10,7 @@
 #include "device_launch_parameters.h"
 
 #include "../../Utils/data_types_common.h"
-#include "../../Utils/sort_interface.h"
+#include "../../Utils/sort_interface_parallel.h"
 #include "../../Utils/kernels_classes.h"
 #include "../../Utils/cuda.h"
 #include "../../Utils/host.h"
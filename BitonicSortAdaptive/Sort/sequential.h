@@ -8,281 +8,226 @@
 #include "../../Utils/data_types_common.h"
 #include "../../Utils/sort_interface.h"
 #include "../../Utils/host.h"
+#include "../../Utils/allocation.h"
+#include "../../Utils/trace.h"
 #include "../data_types.h"
 
 
 /*
 Class for sequential adaptive bitonic sort.
-TODO: reimplement without padding. In previous Git commits it is partially reimplemented without padding.
+
+Bitonic tree is stored in array of nodes (pool), which is reused by all sorts. Before sort node with index "i" holds
+the element with index "i" in array. Root of the tree has index "<tree_length> / 2 - 1" and the last node is a
+spare node, where tree length is array length rounded up to the next power of 2.
+
+Array isn't padded. Nodes with index greater or equal than array length are virtual - they aren't stored in pool
+and they act as elements, which are always sorted at the end of array. Because they are always at the end of bitonic
+sequence, they are never exchanged or moved. This way children of virtual nodes can be computed from their index
+and virtual nodes don't have to be compared with other nodes.
 */
 class BitonicSortAdaptiveSequential : public SortSequential
 {
 protected:
     std::string _sortName = "Bitonic sort adaptive sequential";
-    // Root node of bitonic tree
-    node_t *_root = NULL;
-    // Spare node of bitonic tree (right most element of array)
-    node_t *_spare = NULL;
+    // Pool of nodes of bitonic tree
+    node_t *_nodes = NULL;
+    // Number of nodes in pool
+    uint_t _nodesCapacity = 0;
 
     /*
-    For debugging purposes prints out bitonic tree. Not to be called directly - bottom method calls it.
+    Returns the length of array, on which bitonic tree is built (array length rounded up to the next power of 2).
     */
-    void printBitonicTree(node_t *node, uint_t level)
+    uint_t getBitonicTreeLength(uint_t arrayLength)
     {
-        if (node == NULL)
-        {
-            return;
-        }
-
-        for (uint_t i = 0; i < level; i++)
-        {
-            printf("  ");
-        }
-
-        printf("|%d\n", node->key);
-
-        level++;
-        printBitonicTree(node->left, level);
-        printBitonicTree(node->right, level);
+        return max(nextPowerOf2(arrayLength), 2);
     }
 
     /*
-    For debugging purposes prints out bitonic tree.
+    Returns the distance between node and its children in initial bitonic tree. Node on height "h" (leaves are on
+    height 0) is located on index, which has "h" trailing 1 bits. Its children are located "2 ^ (h - 1)" positions
+    to the left and to the right.
     */
-    void printBitonicTree(node_t *root)
+    uint_t getChildStride(uint_t node)
     {
-        printBitonicTree(root, 0);
+        // Half of the lowest set bit of "node + 1"
+        return ((node + 1) & (~node)) >> 1;
     }
 
     /*
-    Requires root node and stride (at beginning this is "<array_length> / 4").
+    Returns index of left child of node. Children of virtual nodes never change.
     */
-    void constructBitonicTree(node_t *parent, int_t stride)
+    uint_t getLeftChild(node_t *nodes, uint_t node, uint_t arrayLength)
     {
-        if (stride == 0)
+        if (node < arrayLength)
         {
-            return;
+            return nodes[node].left;
         }
 
-        parent->left = new node_t();
-        parent->right = new node_t();
-
-        constructBitonicTree(parent->left, stride / 2);
-        constructBitonicTree(parent->right, stride / 2);
+        uint_t stride = getChildStride(node);
+        return stride > 0 ? node - stride : NULL_NODE;
     }
 
     /*
-    Method for allocating memory needed both for key only and key-value sort.
-    */
-    virtual void memoryAllocate(data_t *h_keys, data_t *h_values, uint_t arrayLength)
-    {
-        SortSequential::memoryAllocate(h_keys, h_values, arrayLength);
-
-        _root = new Node();
-        _spare = new Node();
-
-        constructBitonicTree(_root, nextPowerOf2(arrayLength) / 4);
-    }
-
-    /*
-    Fills bitonic tree with keys from array and generates unique values.
+    For debugging purposes prints out bitonic tree. Not to be called directly - bottom method calls it.
     */
-    template <data_t minMaxValue>
-    void fillBitonicTreeKeyOnly(data_t *keys, node_t *node, uint_t arrayLength, data_t arrayIndex, int_t stride)
+    void printBitonicTree(node_t *nodes, uint_t node, uint_t arrayLength, uint_t level)
     {
-        if (node == NULL)
+        if (node == NULL_NODE)
         {
             return;
         }
 
-        node->key = arrayIndex < arrayLength ? keys[arrayIndex] : minMaxValue;
-        node->value = arrayIndex;
-
-        fillBitonicTreeKeyOnly<minMaxValue>(keys, node->left, arrayLength, arrayIndex - stride, stride / 2);
-        fillBitonicTreeKeyOnly<minMaxValue>(keys, node->right, arrayLength, arrayIndex + stride, stride / 2);
-    }
+        for (uint_t i = 0; i < level; i++)
+        {
+            printf("  ");
+        }
 
-    /*
-    Fills bitonic tree with keys and values.
-    */
-    template <data_t minMaxValue>
-    void fillBitonicTreeKeyValue(
-        data_t *h_keys, data_t *h_values, node_t *node, uint_t arrayLength, uint_t arrayIndex, int_t stride
-    )
-    {
-        if (node == NULL)
+        if (node < arrayLength)
         {
-            return;
+            printf("|%d\n", nodes[node].key);
+        }
+        else
+        {
+            printf("|virtual\n");
         }
 
-        node->key = arrayIndex < arrayLength ? h_keys[arrayIndex] : minMaxValue;
-        node->value = arrayIndex < arrayLength ? h_values[arrayIndex] : arrayIndex;
+        level++;
+        printBitonicTree(nodes, getLeftChild(nodes, node, arrayLength), arrayLength, level);
 
-        fillBitonicTreeKeyValue<minMaxValue>(
-            h_keys, h_values, node->left, arrayLength, arrayIndex - stride, stride / 2
-        );
-        fillBitonicTreeKeyValue<minMaxValue>(
-            h_keys, h_values, node->right, arrayLength, arrayIndex + stride, stride / 2
+        uint_t stride = getChildStride(node);
+        printBitonicTree(
+            nodes, node < arrayLength ? nodes[node].right : (stride > 0 ? node + stride : NULL_NODE), arrayLength,
+            level
         );
     }
 
     /*
-    Memory copy operations needed before sort. If sorting keys only, than "h_values" contains NULL.
+    For debugging purposes prints out bitonic tree.
     */
-    virtual void memoryCopyBeforeSort(data_t *h_keys, data_t *h_values, uint_t arrayLength)
+    void printBitonicTree(node_t *nodes, uint_t root, uint_t arrayLength)
     {
-        SortSequential::memoryCopyBeforeSort(h_keys, h_values, arrayLength);
-
-        uint_t arrayLenPowerOf2 = nextPowerOf2(arrayLength);
-        uint_t rootIndex = arrayLenPowerOf2 / 2 - 1;
-        bool sortingKeyOnly = h_values == NULL;
-
-        if (sortingKeyOnly)
-        {
-            if (_sortOrder == ORDER_ASC)
-            {
-                fillBitonicTreeKeyOnly<MAX_VAL>(h_keys, _root, arrayLength, rootIndex, arrayLenPowerOf2 / 4);
-            }
-            else
-            {
-                fillBitonicTreeKeyOnly<MIN_VAL>(h_keys, _root, arrayLength, rootIndex, arrayLenPowerOf2 / 4);
-            }
-        }
-        else
-        {
-            if (_sortOrder == ORDER_ASC)
-            {
-                fillBitonicTreeKeyValue<MAX_VAL>(
-                    h_keys, h_values, _root, arrayLength, rootIndex, arrayLenPowerOf2 / 4
-                );
-            }
-            else
-            {
-                fillBitonicTreeKeyValue<MIN_VAL>(
-                    h_keys, h_values, _root, arrayLength, rootIndex, arrayLenPowerOf2 / 4
-                );
-            }
-        }
-
-        if (arrayLength == arrayLenPowerOf2)
-        {
-            _spare->key = h_keys[arrayLength - 1];
-            _spare->value = sortingKeyOnly ? arrayLength - 1 : h_values[arrayLength - 1];
-        }
-        else
-        {
-            _spare->key = _sortOrder == ORDER_ASC ? MAX_VAL : MIN_VAL;
-            _spare->value = arrayLenPowerOf2 - 1;
-        }
+        printBitonicTree(nodes, root, arrayLength, 0);
     }
 
     /*
-    Converts bitonic tree to array of keys. Doesn't put value of spare node into array.
-    Not to be called directly - bottom function calls it.
+    Method for allocating memory needed both for key only and key-value sort. Pool of nodes is reallocated only if
+    it is too small.
     */
-    void bitonicTreeToArrayKeyOnly(data_t *h_keys, node_t *node, uint_t arrayLength, uint_t arrayIndex, uint_t stride)
+    virtual void memoryAllocate(data_t *h_keys, data_t *h_values, uint_t arrayLength)
     {
-        if (arrayIndex < arrayLength)
-        {
-            h_keys[arrayIndex] = node->key;
-        }
+        SortSequential::memoryAllocate(h_keys, h_values, arrayLength);
 
-        if (stride == 0)
+        if (arrayLength <= _nodesCapacity)
         {
             return;
         }
 
-        bitonicTreeToArrayKeyOnly(h_keys, node->left, arrayLength, arrayIndex - stride, stride / 2);
-        if (arrayIndex < arrayLength)
-        {
-            bitonicTreeToArrayKeyOnly(h_keys, node->right, arrayLength, arrayIndex + stride, stride / 2);
-        }
+        trackedFree(_nodes);
+        _nodes = (node_t*)trackedMalloc(arrayLength * sizeof(*_nodes));
+        checkMallocError(_nodes);
+        _nodesCapacity = arrayLength;
     }
 
     /*
-    Converts bitonic tree to array of keys and values. Doesn't put value of spare node into array.
-    Not to be called directly - bottom function calls it.
+    Fills bitonic tree with keys (and values) from array. Node with index "i" gets the element with index "i".
+    If sorting keys only, than "h_values" contains NULL and original positions of elements are used as values.
     */
-    void bitonicTreeToArrayKeyValue(
-        data_t *h_keys, data_t *h_values, node_t *node, uint_t arrayLength, uint_t arrayIndex, uint_t stride
-    )
+    void fillBitonicTree(data_t *h_keys, data_t *h_values, node_t *nodes, uint_t arrayLength, uint_t treeLength)
     {
-        if (arrayIndex < arrayLength)
+        for (uint_t i = 0; i < arrayLength; i++)
         {
-            h_keys[arrayIndex] = node->key;
-            h_values[arrayIndex] = node->value;
-        }
+            uint_t stride = getChildStride(i);
 
-        if (stride == 0)
-        {
-            return;
+            nodes[i].key = h_keys[i];
+            nodes[i].value = h_values != NULL ? h_values[i] : i;
+            // Spare node (the last node) doesn't have children
+            nodes[i].left = stride > 0 && i < treeLength - 1 ? i - stride : NULL_NODE;
+            nodes[i].right = stride > 0 && i < treeLength - 1 ? i + stride : NULL_NODE;
         }
+    }
 
-        bitonicTreeToArrayKeyValue(h_keys, h_values, node->left, arrayLength, arrayIndex - stride, stride / 2);
-        if (arrayIndex < arrayLength)
-        {
-            bitonicTreeToArrayKeyValue(h_keys, h_values, node->right, arrayLength, arrayIndex + stride, stride / 2);
-        }
+    /*
+    Memory copy operations needed before sort. If sorting keys only, than "h_values" contains NULL.
+    */
+    virtual void memoryCopyBeforeSort(data_t *h_keys, data_t *h_values, uint_t arrayLength)
+    {
+        SortSequential::memoryCopyBeforeSort(h_keys, h_values, arrayLength);
+        fillBitonicTree(h_keys, h_values, _nodes, arrayLength, getBitonicTreeLength(arrayLength));
     }
 
     /*
-    Copies data from device to host. If sorting keys only, than "h_values" contains NULL.
+    Converts bitonic tree to array. Tree is traversed with explicit stack, which holds nodes together with their
+    position in array. Positions of nodes are determined by the shape of the tree, which doesn't change during sort.
+    Right subtrees of virtual nodes contain only virtual nodes, so they are skipped.
     */
-    virtual void memoryCopyAfterSort(data_t *h_keys, data_t *h_values, uint_t arrayLength)
+    void bitonicTreeToArray(
+        data_t *h_keys, data_t *h_values, node_t *nodes, uint_t arrayLength, uint_t treeLength
+    )
     {
-        SortSequential::memoryCopyAfterSort(h_keys, h_values, arrayLength);
-        bool sortingKeyOnly = h_values == NULL;
+        // Depth of the tree is lower than the number of bits in index
+        uint_t stackNodes[2 * sizeof(uint_t) * 8], stackIndexes[2 * sizeof(uint_t) * 8];
+        uint_t stackSize = 0;
 
-        if (arrayLength == 1)
+        // Spare node
+        if (treeLength - 1 < arrayLength)
         {
-            h_keys[0] = _root->key;
-            if (!sortingKeyOnly)
+            h_keys[treeLength - 1] = nodes[treeLength - 1].key;
+            if (h_values != NULL)
             {
-                h_values[0] = _root->value;
+                h_values[treeLength - 1] = nodes[treeLength - 1].value;
             }
-            return;
         }
 
-        uint_t arrayLenPower2 = nextPowerOf2(arrayLength);
+        stackNodes[stackSize] = treeLength / 2 - 1;
+        stackIndexes[stackSize++] = treeLength / 2 - 1;
 
-        if (sortingKeyOnly)
-        {
-            bitonicTreeToArrayKeyOnly(h_keys, _root, arrayLength, arrayLenPower2 / 2 - 1, arrayLenPower2 / 4);
-        }
-        else
+        while (stackSize > 0)
         {
-            bitonicTreeToArrayKeyValue(
-                h_keys, h_values, _root, arrayLength, arrayLenPower2 / 2 - 1, arrayLenPower2 / 4
-            );
-        }
+            uint_t node = stackNodes[--stackSize];
+            uint_t arrayIndex = stackIndexes[stackSize];
+            uint_t stride = getChildStride(arrayIndex);
 
-        // If array was padded, then there is no need to insert a spare node in last element of array.
-        if (arrayLength < arrayLenPower2)
-        {
-            return;
-        }
+            if (stride == 0 && node >= arrayLength)
+            {
+                continue;
+            }
 
-        // Inserts spare node
-        h_keys[arrayLength - 1] = _spare->key;
-        if (!sortingKeyOnly)
-        {
-            h_values[arrayLength - 1] = _spare->value;
+            // Virtual nodes are located at the end of array
+            if (node >= arrayLength)
+            {
+                stackNodes[stackSize] = node - stride;
+                stackIndexes[stackSize++] = arrayIndex - stride;
+                continue;
+            }
+
+            h_keys[arrayIndex] = nodes[node].key;
+            if (h_values != NULL)
+            {
+                h_values[arrayIndex] = nodes[node].value;
+            }
+
+            if (stride == 0)
+            {
+                continue;
+            }
+
+            if (arrayIndex + 1 < arrayLength)
+            {
+                stackNodes[stackSize] = nodes[node].right;
+                stackIndexes[stackSize++] = arrayIndex + stride;
+            }
+            stackNodes[stackSize] = nodes[node].left;
+            stackIndexes[stackSize++] = arrayIndex - stride;
         }
     }
 
     /*
-    Deletes bitonic tree.
+    Copies sorted data from bitonic tree to array. If sorting keys only, than "h_values" contains NULL.
     */
-    void deleteBitonicTree(node_t *node)
+    virtual void memoryCopyAfterSort(data_t *h_keys, data_t *h_values, uint_t arrayLength)
     {
-        if (node == NULL)
-        {
-            return;
-        }
-
-        deleteBitonicTree(node->left);
-        deleteBitonicTree(node->right);
-        delete node;
+        SortSequential::memoryCopyAfterSort(h_keys, h_values, arrayLength);
+        bitonicTreeToArray(h_keys, h_values, _nodes, arrayLength, getBitonicTreeLength(arrayLength));
     }
 
     /*
@@ -306,7 +251,7 @@ protected:
     */
     void swapLeftNode(node_t *node1, node_t *node2)
     {
-        node_t *node = node1->left;
+        uint32_t node = node1->left;
         node1->left = node2->left;
         node2->left = node;
     }
@@ -316,52 +261,70 @@ protected:
     */
     void swapRightNode(node_t *node1, node_t *node2)
     {
-        node_t *node = node1->right;
+        uint32_t node = node1->right;
         node1->right = node2->right;
         node2->right = node;
     }
 
     /*
-    Executes adaptive bitonic merge.
+    Returns true, if nodes have to be exchanged according to sort order.
 
     Adaptive bitonic merge works only for dictinct sequences. In case of duplicates in sequence values are compared
     by their position in original (not sorted) array.
     */
     template <order_t sortOrder>
-    void bitonicMerge(node_t *root, node_t *spare)
+    bool isExchangeNeeded(node_t *node1, node_t *node2)
     {
-        // Compares keys according to sort order
-        bool rightExchange = sortOrder == ORDER_ASC ? (root->key > spare->key) : (root->key < spare->key);
+        if (node1->key == node2->key)
+        {
+            return sortOrder == ORDER_ASC ? node1->value > node2->value : node1->value < node2->value;
+        }
+
+        return sortOrder == ORDER_ASC ? node1->key > node2->key : node1->key < node2->key;
+    }
+
+    /*
+    Executes one phase of adaptive bitonic merge. Compares root with spare node and then exchanges elements and
+    subtrees on one path from root to leaf. After the phase left and right subtree of root can be merged
+    independently from each other.
 
-        // In case of duplicates, ties are resolved according to element position in original unsorted array
-        if (!rightExchange)
+    Virtual nodes can be located only in the right subtree and they are never exchanged. If root is virtual, then
+    all nodes in its right subtree are virtual and there is nothing to exchange.
+    */
+    template <order_t sortOrder>
+    void bitonicMergePhase(node_t *nodes, uint_t root, uint_t spare, uint_t arrayLength)
+    {
+        if (root >= arrayLength)
         {
-            rightExchange = root->key == spare->key && (
-                sortOrder == ORDER_ASC ? root->value > spare->value : root->value < spare->value
-            );
+            return;
         }
 
+        node_t *rootNode = &nodes[root];
+        bool rightExchange = spare < arrayLength && isExchangeNeeded<sortOrder>(rootNode, &nodes[spare]);
+
         if (rightExchange)
         {
-            swapNodeKeyValue(root, spare);
+            swapNodeKeyValue(rootNode, &nodes[spare]);
         }
 
-        node_t *leftNode = root->left;
-        node_t *rightNode = root->right;
+        uint_t leftIndex = rootNode->left;
+        uint_t rightIndex = rootNode->right;
 
-        while (leftNode != NULL)
+        while (leftIndex != NULL_NODE)
         {
-            // Compares keys according to sort order
-            bool elementExchange = sortOrder == ORDER_ASC ? (leftNode->key > rightNode->key) : (leftNode->key < rightNode->key);
+            node_t *leftNode = &nodes[leftIndex];
 
-            // In case of duplicates, ties are resolved according to element position in original unsorted array
-            if (!elementExchange)
+            // Virtual node exists only if spare is virtual, so "rightExchange" is false
+            if (rightIndex >= arrayLength)
             {
-                elementExchange = leftNode->key == rightNode->key && (
-                    sortOrder == ORDER_ASC ? leftNode->value > rightNode->value : leftNode->value < rightNode->value
-                );
+                leftIndex = leftNode->left;
+                rightIndex = getLeftChild(nodes, rightIndex, arrayLength);
+                continue;
             }
 
+            node_t *rightNode = &nodes[rightIndex];
+            bool elementExchange = isExchangeNeeded<sortOrder>(leftNode, rightNode);
+
             if (rightExchange)
             {
                 if (elementExchange)
@@ -369,13 +332,13 @@ protected:
                     swapNodeKeyValue(leftNode, rightNode);
                     swapRightNode(leftNode, rightNode);
 
-                    leftNode = leftNode->left;
-                    rightNode = rightNode->left;
+                    leftIndex = leftNode->left;
+                    rightIndex = rightNode->left;
                 }
                 else
                 {
-                    leftNode = leftNode->right;
-                    rightNode = rightNode->right;
+                    leftIndex = leftNode->right;
+                    rightIndex = rightNode->right;
                 }
             }
             else
@@ -385,43 +348,79 @@ protected:
                     swapNodeKeyValue(leftNode, rightNode);
                     swapLeftNode(leftNode, rightNode);
 
-                    leftNode = leftNode->right;
-                    rightNode = rightNode->right;
+                    leftIndex = leftNode->right;
+                    rightIndex = rightNode->right;
                 }
                 else
                 {
-                    leftNode = leftNode->left;
-                    rightNode = rightNode->left;
+                    leftIndex = leftNode->left;
+                    rightIndex = rightNode->left;
                 }
             }
         }
+    }
+
+    /*
+    Executes adaptive bitonic merge. Subtrees, which contain only virtual nodes, are skipped.
+    */
+    template <order_t sortOrder>
+    void bitonicMerge(node_t *nodes, uint_t root, uint_t spare, uint_t arrayLength)
+    {
+        bitonicMergePhase<sortOrder>(nodes, root, spare, arrayLength);
+
+        uint_t left = getLeftChild(nodes, root, arrayLength);
+        if (left == NULL_NODE)
+        {
+            return;
+        }
 
-        if (root->left != NULL)
+        bitonicMerge<sortOrder>(nodes, left, root, arrayLength);
+        if (root < arrayLength)
         {
-            bitonicMerge<sortOrder>(root->left, root);
-            bitonicMerge<sortOrder>(root->right, spare);
+            bitonicMerge<sortOrder>(nodes, nodes[root].right, spare, arrayLength);
         }
     }
 
     /*
     Executes adaptive bitonic sort on provided bitonic tree. Requires root node of bitonic tree, spare node
     (at beginning this is node with last array element with no children and parents) and sort order.
+
+    Left subtree is sorted in opposite order than right subtree. This way virtual nodes, which are always at the end,
+    keep the sequence bitonic. If root is virtual, only left subtree contains elements, so it is sorted directly in
+    requested order.
     */
     template <order_t sortOrder>
-    void bitonicSortAdaptiveSequential(node_t *root, node_t *spare)
+    void bitonicSortAdaptiveSequential(node_t *nodes, uint_t root, uint_t spare, uint_t arrayLength)
     {
-        if (root->left == NULL)
+        if (root >= arrayLength)
+        {
+            uint_t left = getLeftChild(nodes, root, arrayLength);
+            if (left != NULL_NODE)
+            {
+                bitonicSortAdaptiveSequential<sortOrder>(nodes, left, root, arrayLength);
+            }
+            return;
+        }
+
+        node_t *rootNode = &nodes[root];
+
+        if (rootNode->left == NULL_NODE)
         {
-            if (sortOrder == ORDER_ASC ? (root->key > spare->key) : (root->key < spare->key))
+            if (spare < arrayLength && isExchangeNeeded<sortOrder>(rootNode, &nodes[spare]))
             {
-                swapNodeKeyValue(root, spare);
+                swapNodeKeyValue(rootNode, &nodes[spare]);
             }
         }
         else
         {
-            bitonicSortAdaptiveSequential<sortOrder>(root->left, root);
-            bitonicSortAdaptiveSequential<(order_t)!sortOrder>(root->right, spare);
-            bitonicMerge<sortOrder>(root, spare);
+            bitonicSortAdaptiveSequential<(order_t)!sortOrder>(nodes, rootNode->left, root, arrayLength);
+            bitonicSortAdaptiveSequential<sortOrder>(nodes, rootNode->right, spare, arrayLength);
+
+            // Subtree (including spare node) contains 4 times as many nodes as is the stride of its root
+            TRACE_SCOPE_SIZED(
+                "adaptive bitonic merge", "subtree size", 4 * getChildStride(root), 4 * getChildStride(root)
+            );
+            bitonicMerge<sortOrder>(nodes, root, spare, arrayLength);
         }
     }
 
@@ -431,13 +430,15 @@ protected:
     */
     void sortKeyOnly()
     {
+        uint_t treeLength = getBitonicTreeLength(_arrayLength);
+
         if (_sortOrder == ORDER_ASC)
         {
-            bitonicSortAdaptiveSequential<ORDER_ASC>(_root, _spare);
+            bitonicSortAdaptiveSequential<ORDER_ASC>(_nodes, treeLength / 2 - 1, treeLength - 1, _arrayLength);
         }
         else
         {
-            bitonicSortAdaptiveSequential<ORDER_DESC>(_root, _spare);
+            bitonicSortAdaptiveSequential<ORDER_DESC>(_nodes, treeLength / 2 - 1, treeLength - 1, _arrayLength);
         }
     }
 
@@ -455,6 +456,21 @@ public:
         return this->_sortName;
     }
 
+    /*
+    Keys and values are stored in nodes of bitonic tree. Adaptive bitonic merge reads and writes every node of
+    subtree once, so sort reads and writes every node once on all "log2(n)" levels of bitonic tree. Levels with
+    subtrees, which fit into last level cache, read and write nodes from main memory only once. Filling of tree and
+    reading of sorted array from it aren't timed.
+    */
+    double getBytesMoved()
+    {
+        double numLevels = log2((double)getBitonicTreeLength(_arrayLength));
+        double numMemoryLevels = getNumMemoryLevels(numLevels, 2, sizeof(*_nodes));
+        double numPasses = numMemoryLevels < numLevels ? numMemoryLevels + 1 : numLevels;
+
+        return 2 * numPasses * _arrayLength * sizeof(*_nodes);
+    }
+
     /*
     Method for destroying memory needed for sort. For sort testing purposes this method is public.
     */
@@ -467,8 +483,9 @@ public:
 
         SortSequential::memoryDestroy();
 
-        deleteBitonicTree(_root);
-        delete _spare;
+        trackedFree(_nodes);
+        _nodes = NULL;
+        _nodesCapacity = 0;
     }
 };
 
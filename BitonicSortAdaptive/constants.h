@@ -101,4 +101,14 @@ _KV:  Key-value
 #define ELEMS_GEN_INTERVALS_KV 2
 #endif
 
+
+/* -------- MULTITHREADED ALGORITHM PARAMETERS ------- */
+
+// Subtrees of bitonic tree with this many nodes or less are sorted and merged sequentially by one task. Has to be
+// power of 2. Min value is 2.
+#define SEQUENTIAL_CUTOFF_MULTITHREADED (1 << 13)
+// Minimal number of tasks created per thread, when subtrees are sorted or merged in parallel. More tasks give better
+// load balance, because merge phases don't take the same time for all subtrees.
+#define TASKS_PER_THREAD_MULTITHREADED 4
+
 #endif
@@ -3,9 +3,12 @@
 
 #include <stdint.h>
 
+#include "../Utils/data_types_common.h"
+
 
 typedef struct Interval interval_t;
 typedef struct Node node_t;
+typedef struct Subtree subtree_t;
 
 /*
 Holds 2 intervals needed for IBR bitonic sort.
@@ -20,32 +23,31 @@ struct Interval
 };
 
 /*
-Represents a Node in bitonic tree needed for adaptive bitonic sort.
+Represents a Node in bitonic tree needed for adaptive bitonic sort. Nodes are stored in array (pool) and children
+are represented with their indexes in this array.
 
 Adaptive bitonic sort works only for distinct sequences. If sequence isn't distinct, ties can be broken by the
 element's original position in array. This is why this structure contains property "value" alongside property "key".
 */
 struct Node
 {
-    data_t key;    // Holds value from array
-    data_t value;   // Holds an index of element in original (not sorted) array
-    node_t *left;
-    node_t *right;
-
-    Node(data_t key, data_t value, node_t *left, node_t *right)
-    {
-
-        this->key = key;
-        this->value = value;
-        this->left = left;
-        this->right = right;
-    }
-
-    Node(data_t key, data_t value) : Node(key, value, NULL, NULL) {}
+    data_t key;      // Holds value from array
+    data_t value;    // Holds an index of element in original (not sorted) array
+    uint32_t left;   // Index of left child or NULL_NODE
+    uint32_t right;  // Index of right child or NULL_NODE
+};
 
-    Node(data_t key) : Node(key, key, NULL, NULL) {}
+// Index, which denotes that node doesn't have a child
+#define NULL_NODE UINT32_MAX
 
-    Node() : Node(NULL, NULL, NULL, NULL) {}
+/*
+Subtree of bitonic tree, which is sorted or merged by one task in multithreaded adaptive bitonic sort.
+*/
+struct Subtree
+{
+    uint32_t root;      // Index of root node of subtree
+    uint32_t spare;     // Index of spare node of subtree
+    order_t sortOrder;  // Order, in which subtree is sorted or merged
 };
 
 #endif
@@ -0,0 +1,409 @@
+#ifndef BITONIC_SORT_MULTISTEP_MULTITHREADED_H
+#define BITONIC_SORT_MULTISTEP_MULTITHREADED_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "../../Utils/data_types_common.h"
+#include "../../Utils/threads.h"
+#include "../../Utils/simd.h"
+#include "../../Utils/host.h"
+#include "../../Utils/trace.h"
+#include "../../BitonicSort/Sort/sequential_simd.h"
+#include "../constants.h"
+
+
+/*
+Base class for multithreaded multistep bitonic sort.
+Needed for template specialization.
+
+CPU port of multistep bitonic sort. Array is divided into blocks, which fit into L2 cache. Blocks are sorted and
+merged by threads independently from each other, so all steps with stride lower than L2 block are executed with
+one visit of block. Inside L2 block steps with stride lower than L1 block are executed with one visit of L1 block.
+Steps with stride greater or equal than L2 block are grouped into multisteps, which execute multiple steps in one
+pass over array (same as multistep kernel on GPU).
+
+Template params:
+_Ko - Key-only
+_Kv - Key-value
+*/
+template <
+    uint_t blockSizeL1Ko, uint_t blockSizeL2Ko, uint_t maxMultistepKo,
+    uint_t blockSizeL1Kv, uint_t blockSizeL2Kv, uint_t maxMultistepKv
+>
+class BitonicSortMultistepMultithreadedBase : public BitonicSortSequentialSimd
+{
+    static_assert(
+        blockSizeL1Ko >= 2 * SIMD_WIDTH && blockSizeL1Kv >= 2 * SIMD_WIDTH,
+        "L1 block in multithreaded bitonic sort has to contain at least two vectors."
+    );
+    static_assert(
+        blockSizeL2Ko >= blockSizeL1Ko && blockSizeL2Kv >= blockSizeL1Kv,
+        "L2 block in multithreaded bitonic sort has to be greater or equal than L1 block."
+    );
+
+protected:
+    std::string _sortName = "Bitonic sort multistep multithreaded";
+
+    /*
+    Executes "degree" steps of bitonic merge in one pass over array for provided interval of groups. Every group
+    consists of "2 ^ degree" vectors, which are exchanged only between themselves in these steps. Groups, which
+    are only partially inside array, are processed with scalar compare-exchanges.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly, uint_t degree>
+    void bitonicMultistepSimd(
+        data_t *h_keys, data_t *h_values, uint_t stride, uint_t groupStart, uint_t groupEnd, uint_t arrayLength
+    )
+    {
+        const uint_t numVectors = 1 << degree;
+        // Stride of the last step in multistep
+        uint_t innerStride = stride >> (degree - 1);
+        uint_t groupsPerBlock = innerStride / SIMD_WIDTH;
+        simd_t keys[numVectors], values[numVectors];
+
+        for (uint_t group = groupStart; group < groupEnd; group++)
+        {
+            uint_t index = (group / groupsPerBlock) * 2 * stride + (group % groupsPerBlock) * SIMD_WIDTH;
+
+            // None of the elements in group has a pair inside array
+            if (index + innerStride >= arrayLength)
+            {
+                continue;
+            }
+
+            if (index + (numVectors - 1) * innerStride + SIMD_WIDTH > arrayLength)
+            {
+                for (uint_t lane = 0; lane < SIMD_WIDTH; lane++)
+                {
+                    for (uint_t vectorStride = numVectors / 2; vectorStride > 0; vectorStride >>= 1)
+                    {
+                        for (uint_t v = 0; v < numVectors; v++)
+                        {
+                            uint_t indexLeft = index + lane + v * innerStride;
+                            uint_t indexRight = indexLeft + vectorStride * innerStride;
+
+                            if ((v & vectorStride) == 0 && indexRight < arrayLength)
+                            {
+                                compareExchange<sortOrder, sortingKeyOnly>(h_keys, h_values, indexLeft, indexRight);
+                            }
+                        }
+                    }
+                }
+                continue;
+            }
+
+            for (uint_t v = 0; v < numVectors; v++)
+            {
+                keys[v] = simdLoad(h_keys + index + v * innerStride);
+                if (!sortingKeyOnly)
+                {
+                    values[v] = simdLoad(h_values + index + v * innerStride);
+                }
+            }
+
+            for (uint_t vectorStride = numVectors / 2; vectorStride > 0; vectorStride >>= 1)
+            {
+                for (uint_t v = 0; v < numVectors; v++)
+                {
+                    if ((v & vectorStride) == 0)
+                    {
+                        compareExchangeSimd<sortOrder, sortingKeyOnly>(
+                            keys[v], keys[v + vectorStride], values[v], values[v + vectorStride]
+                        );
+                    }
+                }
+            }
+
+            for (uint_t v = 0; v < numVectors; v++)
+            {
+                simdStore(h_keys + index + v * innerStride, keys[v]);
+                if (!sortingKeyOnly)
+                {
+                    simdStore(h_values + index + v * innerStride, values[v]);
+                }
+            }
+        }
+    }
+
+    /*
+    Executes multistep of provided degree with multiple threads.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly>
+    void runMultistep(
+        data_t *h_keys, data_t *h_values, uint_t stride, uint_t degree, uint_t numThreads, uint_t arrayLength
+    )
+    {
+        uint_t innerStride = stride >> (degree - 1);
+        uint_t numBlocks = (arrayLength - 1) / (2 * stride) + 1;
+        uint_t numGroups = numBlocks * (innerStride / SIMD_WIDTH);
+
+        parallelFor(numThreads, [&](uint_t threadIndex) {
+            uint_t groupStart = (uint_t)((uint64_t)numGroups * threadIndex / numThreads);
+            uint_t groupEnd = (uint_t)((uint64_t)numGroups * (threadIndex + 1) / numThreads);
+
+            switch (degree)
+            {
+                case 1:
+                    bitonicMultistepSimd<sortOrder, sortingKeyOnly, 1>(
+                        h_keys, h_values, stride, groupStart, groupEnd, arrayLength
+                    );
+                    break;
+                case 2:
+                    bitonicMultistepSimd<sortOrder, sortingKeyOnly, 2>(
+                        h_keys, h_values, stride, groupStart, groupEnd, arrayLength
+                    );
+                    break;
+                case 3:
+                    bitonicMultistepSimd<sortOrder, sortingKeyOnly, 3>(
+                        h_keys, h_values, stride, groupStart, groupEnd, arrayLength
+                    );
+                    break;
+                case 4:
+                    bitonicMultistepSimd<sortOrder, sortingKeyOnly, 4>(
+                        h_keys, h_values, stride, groupStart, groupEnd, arrayLength
+                    );
+                    break;
+                case 5:
+                    bitonicMultistepSimd<sortOrder, sortingKeyOnly, 5>(
+                        h_keys, h_values, stride, groupStart, groupEnd, arrayLength
+                    );
+                    break;
+                case 6:
+                    bitonicMultistepSimd<sortOrder, sortingKeyOnly, 6>(
+                        h_keys, h_values, stride, groupStart, groupEnd, arrayLength
+                    );
+                    break;
+                default:
+                    printf("Multistep degree %d is not supported.\n", degree);
+                    exit(EXIT_FAILURE);
+            }
+        });
+    }
+
+    /*
+    Executes the first step of phase with multiple threads. Every block is divided into intervals, which touch
+    L2 block of elements.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly, uint_t blockSizeL2>
+    void runFirstStep(
+        data_t *h_keys, data_t *h_values, simd_network_t *network, uint_t stride, uint_t numThreads,
+        uint_t arrayLength
+    )
+    {
+        const uint_t intervalSize = blockSizeL2 / 2;
+        uint_t intervalsPerBlock = stride / intervalSize;
+        uint_t numBlocks = (arrayLength - stride - 1) / (2 * stride) + 1;
+        uint_t numIntervals = numBlocks * intervalsPerBlock;
+
+        parallelFor(numThreads, [&](uint_t threadIndex) {
+            uint_t intervalStart = (uint_t)((uint64_t)numIntervals * threadIndex / numThreads);
+            uint_t intervalEnd = (uint_t)((uint64_t)numIntervals * (threadIndex + 1) / numThreads);
+
+            for (uint_t interval = intervalStart; interval < intervalEnd; interval++)
+            {
+                uint_t jStart = (interval % intervalsPerBlock) * intervalSize;
+
+                bitonicFirstStepBlockSimd<sortOrder, sortingKeyOnly>(
+                    h_keys, h_values, network->reversePermutation, stride,
+                    (interval / intervalsPerBlock) * 2 * stride, jStart, jStart + intervalSize, arrayLength
+                );
+            }
+        });
+    }
+
+    /*
+    Executes all remaining steps of bitonic merge in L2 block. Steps with stride lower than L1 block are executed
+    for every L1 block separately.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly, uint_t blockSizeL1>
+    void bitonicMergeBlock(
+        data_t *h_keys, data_t *h_values, simd_network_t *network, uint_t stride, uint_t blockLength
+    )
+    {
+        for (; 2 * stride > blockSizeL1; stride >>= 1)
+        {
+            bitonicMergeStepSimd<sortOrder, sortingKeyOnly>(h_keys, h_values, stride, blockLength);
+        }
+
+        for (uint_t offset = 0; offset < blockLength; offset += blockSizeL1)
+        {
+            data_t *h_keysL1 = h_keys + offset;
+            data_t *h_valuesL1 = sortingKeyOnly ? NULL : h_values + offset;
+            uint_t blockLengthL1 = min(blockSizeL1, blockLength - offset);
+
+            for (uint_t strideL1 = stride; strideL1 >= SIMD_WIDTH; strideL1 >>= 1)
+            {
+                bitonicMergeStepSimd<sortOrder, sortingKeyOnly>(h_keysL1, h_valuesL1, strideL1, blockLengthL1);
+            }
+
+            executeStepsSimd<sortOrder, sortingKeyOnly>(
+                h_keysL1, h_valuesL1, network->mergePermutations, network->mergeUpperLanes, network->numMergeSteps,
+                blockLengthL1
+            );
+        }
+    }
+
+    /*
+    Sorts data with NORMALIZED MULTISTEP BITONIC SORT on multiple threads.
+    */
+    template <
+        order_t sortOrder, bool sortingKeyOnly, uint_t blockSizeL1, uint_t blockSizeL2, uint_t maxMultistep
+    >
+    void bitonicSortMultistepMultithreaded(data_t *h_keys, data_t *h_values, uint_t numThreads, uint_t arrayLength)
+    {
+        uint_t numBlocks = (arrayLength - 1) / blockSizeL2 + 1;
+        simd_network_t network;
+
+        createNetworkSimd(&network);
+
+        // All phases with sub-block size lower than L2 block are executed for every L2 block separately
+        parallelFor(numThreads, [&](uint_t threadIndex) {
+            TRACE_SCOPE("bitonic block sort");
+            uint_t blockStart = numBlocks * threadIndex / numThreads;
+            uint_t blockEnd = numBlocks * (threadIndex + 1) / numThreads;
+
+            for (uint_t block = blockStart; block < blockEnd; block++)
+            {
+                uint_t offset = block * blockSizeL2;
+
+                bitonicSortBlockSimd<sortOrder, sortingKeyOnly>(
+                    h_keys + offset, sortingKeyOnly ? NULL : h_values + offset, &network,
+                    min(blockSizeL2, arrayLength - offset)
+                );
+            }
+        });
+
+        // Bitonic merge
+        for (uint_t subBlockSize = blockSizeL2; subBlockSize < arrayLength; subBlockSize <<= 1)
+        {
+            TRACE_SCOPE_ARG("bitonic merge phase", "sub block size", subBlockSize);
+
+            // NORMALIZED bitonic merge for first step of phase, where different pattern of exchanges is used
+            // compared to other steps
+            runFirstStep<sortOrder, sortingKeyOnly, blockSizeL2>(
+                h_keys, h_values, &network, subBlockSize, numThreads, arrayLength
+            );
+
+            // Multisteps for steps with stride greater or equal than L2 block
+            uint_t stride = subBlockSize / 2;
+            uint_t numSteps = stride >= blockSizeL2 ? log2((double)(stride / blockSizeL2)) + 1 : 0;
+
+            for (uint_t degree = min(maxMultistep, numSteps); degree > 0; degree--)
+            {
+                for (; numSteps >= degree; numSteps -= degree, stride >>= degree)
+                {
+                    runMultistep<sortOrder, sortingKeyOnly>(
+                        h_keys, h_values, stride, degree, numThreads, arrayLength
+                    );
+                }
+            }
+
+            // Remaining steps are executed for every L2 block separately
+            parallelFor(numThreads, [&](uint_t threadIndex) {
+                TRACE_SCOPE("bitonic block merge");
+                uint_t blockStart = numBlocks * threadIndex / numThreads;
+                uint_t blockEnd = numBlocks * (threadIndex + 1) / numThreads;
+
+                for (uint_t block = blockStart; block < blockEnd; block++)
+                {
+                    uint_t offset = block * blockSizeL2;
+
+                    bitonicMergeBlock<sortOrder, sortingKeyOnly, blockSizeL1>(
+                        h_keys + offset, sortingKeyOnly ? NULL : h_values + offset, &network, stride,
+                        min(blockSizeL2, arrayLength - offset)
+                    );
+                }
+            });
+        }
+    }
+
+    /*
+    Wrapper for multithreaded multistep bitonic sort method.
+    The code runs faster if arguments are passed to method. If members are accessed directly, code runs slower.
+    */
+    void sortKeyOnly()
+    {
+        if (_sortOrder == ORDER_ASC)
+        {
+            bitonicSortMultistepMultithreaded<ORDER_ASC, true, blockSizeL1Ko, blockSizeL2Ko, maxMultistepKo>(
+                _h_keys, NULL, getNumThreads(), _arrayLength
+            );
+        }
+        else
+        {
+            bitonicSortMultistepMultithreaded<ORDER_DESC, true, blockSizeL1Ko, blockSizeL2Ko, maxMultistepKo>(
+                _h_keys, NULL, getNumThreads(), _arrayLength
+            );
+        }
+    }
+
+    /*
+    Wrapper for multithreaded multistep bitonic sort method.
+    The code runs faster if arguments are passed to method. If members are accessed directly, code runs slower.
+    */
+    void sortKeyValue()
+    {
+        if (_sortOrder == ORDER_ASC)
+        {
+            bitonicSortMultistepMultithreaded<ORDER_ASC, false, blockSizeL1Kv, blockSizeL2Kv, maxMultistepKv>(
+                _h_keys, _h_values, getNumThreads(), _arrayLength
+            );
+        }
+        else
+        {
+            bitonicSortMultistepMultithreaded<ORDER_DESC, false, blockSizeL1Kv, blockSizeL2Kv, maxMultistepKv>(
+                _h_keys, _h_values, getNumThreads(), _arrayLength
+            );
+        }
+    }
+
+public:
+    std::string getSortName()
+    {
+        return this->_sortName;
+    }
+
+    /*
+    Every pass over array reads and writes keys and values once. L2 blocks are sorted in one pass. Every phase
+    of merge consists of the first step, multisteps and one pass over L2 blocks for the remaining steps. Passes are
+    executed from main memory, unless array fits into last level cache.
+    */
+    double getBytesMoved()
+    {
+        bool sortingKeyOnly = _h_values == NULL;
+        uint_t blockSizeL2 = sortingKeyOnly ? blockSizeL2Ko : blockSizeL2Kv;
+        uint_t maxMultistep = sortingKeyOnly ? maxMultistepKo : maxMultistepKv;
+        double numPasses = 1;
+
+        for (uint_t subBlockSize = blockSizeL2; subBlockSize < _arrayLength; subBlockSize <<= 1)
+        {
+            uint_t stride = subBlockSize / 2;
+            uint_t numSteps = stride >= blockSizeL2 ? log2((double)(stride / blockSizeL2)) + 1 : 0;
+            numPasses += 2;
+
+            for (uint_t degree = min(maxMultistep, numSteps); degree > 0; degree--)
+            {
+                for (; numSteps >= degree; numSteps -= degree)
+                {
+                    numPasses++;
+                }
+            }
+        }
+
+        double numMemoryPasses = getNumMemoryLevels(numPasses, 1, getElementSize());
+        return getBytesOfPasses(2 * numMemoryPasses, 2 * numMemoryPasses) +
+            getBytesOfCacheLevels(numPasses, numMemoryPasses);
+    }
+};
+
+/*
+Class for multithreaded multistep bitonic sort.
+*/
+class BitonicSortMultistepMultithreaded : public BitonicSortMultistepMultithreadedBase<
+    BLOCK_SIZE_L1_MULTITHREADED_KO, BLOCK_SIZE_L2_MULTITHREADED_KO, MAX_MULTI_STEP_MULTITHREADED_KO,
+    BLOCK_SIZE_L1_MULTITHREADED_KV, BLOCK_SIZE_L2_MULTITHREADED_KV, MAX_MULTI_STEP_MULTITHREADED_KV
+>
+{};
+
+#endif
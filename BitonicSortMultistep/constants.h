@@ -96,4 +96,35 @@ _KV:  Key-value
 #define ELEMS_LOCAL_MERGE_KV 2
 #endif
 
+
+/* -------- MULTITHREADED ALGORITHM PARAMETERS ------- */
+
+// Size of block in elements, which fits into L1 cache (32 KB). Has to be power of 2 and at least twice the vector
+// width.
+#if DATA_TYPE_BITS == 32
+#define BLOCK_SIZE_L1_MULTITHREADED_KO (1 << 12)
+#define BLOCK_SIZE_L1_MULTITHREADED_KV (1 << 11)
+#else
+#define BLOCK_SIZE_L1_MULTITHREADED_KO (1 << 11)
+#define BLOCK_SIZE_L1_MULTITHREADED_KV (1 << 10)
+#endif
+// Size of block in elements, which fits into L2 cache (256 KB). Every block is sorted and merged by one thread.
+// Has to be power of 2 and greater or equal than BLOCK_SIZE_L1_MULTITHREADED.
+#if DATA_TYPE_BITS == 32
+#define BLOCK_SIZE_L2_MULTITHREADED_KO (1 << 15)
+#define BLOCK_SIZE_L2_MULTITHREADED_KV (1 << 14)
+#else
+#define BLOCK_SIZE_L2_MULTITHREADED_KO (1 << 14)
+#define BLOCK_SIZE_L2_MULTITHREADED_KV (1 << 13)
+#endif
+// How many steps are executed in one pass over array, when stride is greater or equal than L2 block (multistep
+// of degree N holds "2 ^ N" vectors in registers). Min value is 1, max value is 6.
+#if DATA_TYPE_BITS == 32
+#define MAX_MULTI_STEP_MULTITHREADED_KO 4
+#define MAX_MULTI_STEP_MULTITHREADED_KV 3
+#else
+#define MAX_MULTI_STEP_MULTITHREADED_KO 4
+#define MAX_MULTI_STEP_MULTITHREADED_KV 3
+#endif
+
 #endif
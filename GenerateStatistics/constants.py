@@ -38,6 +38,8 @@ SORT_KEY_VALUE = "key_value"
 SORT_SEQUENTIAL = "sequential"
 # Substring which appears in file names for parallel sorts
 SORT_PARALLEL = "parallel"
+# Substring which appears in file names for multithreaded CPU sorts
+SORT_MULTITHREADED = "multithreaded"
 # Ascending sort order
 ORDER_ASC = 0
 # Descending sort order
@@ -30,6 +30,11 @@ reduce_sort_timings(
     const.FOLDER_SORT_TIMERS, array_lens, [const.SORT_KEY_ONLY, const.SORT_SEQUENTIAL]
 )
 
+print("Reducing sort timings for key only multithreaded sort")
+reduce_sort_timings(
+    const.FOLDER_SORT_TIMERS, array_lens, [const.SORT_KEY_ONLY, const.SORT_MULTITHREADED]
+)
+
 print("Reducing sort timings for key value parallel sort")
 reduce_sort_timings(
     const.FOLDER_SORT_TIMERS, array_lens, [const.SORT_KEY_VALUE, const.SORT_PARALLEL]
@@ -39,3 +44,8 @@ print("Reducing sort timings for key value sequential sort")
 reduce_sort_timings(
     const.FOLDER_SORT_TIMERS, array_lens, [const.SORT_KEY_VALUE, const.SORT_SEQUENTIAL]
 )
+
+print("Reducing sort timings for key value multithreaded sort")
+reduce_sort_timings(
+    const.FOLDER_SORT_TIMERS, array_lens, [const.SORT_KEY_VALUE, const.SORT_MULTITHREADED]
+)
@@ -8,31 +8,18 @@ from utils import (
 )
 
 
-def array_len_gen(array_len_start, array_len_end, interval_split=2):
+def test_sorts(exe_path, array_len_start, array_len_end, test_repetitions,
+               sort_order=const.ORDER_ASC, interval_split=2):
     """
-    Generator for array lengths. Interval_split specifies, how many times should interval be
-    sampled/tested between array length 2^n and 2^(n + 1).
+    Tests sorting algorithms for provided array lengths. All array lengths are tested in one process.
+    Interval_split specifies, how many times should interval be sampled/tested between array length 2^n and
+    2^(n + 1).
     """
 
-    array_len = array_len_start
-
-    while array_len < array_len_end:
-        step = int(array_len / interval_split)
-
-        for l in range(array_len, next_power_2(array_len + 1) - step + 1, step):
-            yield l
-
-        array_len = next_power_2(array_len + 1)
-
-    yield array_len
-
-
-def test_sorts(exe_path, array_len_start, array_len_end, test_repetitions,
-               sort_order=const.ORDER_ASC):
-    """Tests sorting algorithms for provided array lengths."""
-
-    for array_len in array_len_gen(array_len_start, array_len_end):
-        subprocess.call([exe_path, str(array_len), str(test_repetitions), str(sort_order)])
+    subprocess.call([
+        exe_path, "--length=%d:%d:%d" % (array_len_start, array_len_end, interval_split),
+        "--repetitions=%d" % test_repetitions, "--order=%s" % ("asc" if sort_order == const.ORDER_ASC else "desc")
+    ])
 
 
 def reduce_predicates(folder_name_pred, output_file_name, file_name_filters=""):
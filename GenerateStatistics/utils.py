@@ -45,8 +45,21 @@ def lengths_to_log(array_lens):
     return const.SEPARATOR.join(array_len_str)
 
 
+def median(values):
+    """Returns median of values."""
+
+    values = sorted(values)
+    middle = len(values) // 2
+
+    if len(values) % 2 == 1:
+        return values[middle]
+    return (values[middle - 1] + values[middle]) / 2
+
+
 def sort_rate(timings, array_len, factor=1000):
-    """Calculates number of elements (millions) that algorithm can sort in one second."""
+    """
+    Calculates number of elements (millions) that algorithm can sort in one second. Median time is used, so
+    outliers (e.g. page faults in one repetition) don't skew the result.
+    """
 
-    avg_time = sum(timings) / len(timings)
-    return array_len / factor / avg_time
+    return array_len / factor / median(timings)
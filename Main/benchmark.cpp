@@ -0,0 +1,537 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include <string>
+
+#include "../Utils/data_types_common.h"
+#include "../Utils/host.h"
+#include "../Utils/generator.h"
+#include "../Utils/threads.h"
+#include "../Utils/timer.h"
+#include "../Utils/perf_counters.h"
+#include "../Utils/bandwidth.h"
+#include "../Utils/sort_interface.h"
+
+#include "sort_registry.h"
+#include "test_sort.h"
+#include "benchmark.h"
+#include "constants.h"
+
+
+/*
+Prints command line usage and names of registered sorts and distributions.
+*/
+static void printUsage(SortRegistry *registry)
+{
+    printf(
+        "Usage: [options] [array length] [number of test repetitions] [sort order] [seed]\n"
+        "Options:\n"
+        "  --sorts=NAME[,NAME...]          sorts to test, default all registered sorts\n"
+        "  --distributions=NAME[,NAME...]  input distributions, default all except staggered\n"
+        "  --mode=key-only|key-value|both  sort keys only, key-value pairs or both, default both\n"
+        "  --length=START[:END[:SPLIT]]    array length or range of array lengths. SPLIT lengths are tested\n"
+        "                                  between 2^n and 2^(n + 1), default %d\n"
+        "  --repetitions=N                 number of test repetitions, default %d\n"
+        "  --order=asc|desc                sort order, default asc\n"
+        "  --seed=N                        seed of input data, default generated from current time. Datasets\n"
+        "                                  are saved to files only if seed is provided\n"
+        "  --threads=N[,N...]              number of threads of multithreaded sorts, default number of CPUs. In\n"
+        "                                  scaling test list of thread counts, default 1, 2, 4 ... number of CPUs\n"
+        "  --scaling=strong|weak|both      tests scalability of multithreaded sorts (default all multithreaded\n"
+        "                                  sorts). In weak scaling array length is length per thread\n"
+        "  --cache=MODE[,MODE...]          state of caches before sort: warm (input in cache), cold (caches are\n"
+        "                                  evicted) or page-cold (evicted caches, freshly mapped memory), default\n"
+        "                                  warm. Not supported in scaling test\n"
+        "  --list                          prints registered sorts and distributions\n"
+        "Positional arguments are supported for compatibility (sort order: 0 - ASC, 1 - DESC).\n",
+        BENCHMARK_DEFAULT_LENGTH_SPLIT, BENCHMARK_DEFAULT_REPETITIONS
+    );
+
+    std::vector<std::string> names = registry->getNames();
+    printf("Sorts:");
+    for (uint_t i = 0; i < names.size(); i++)
+    {
+        printf(" %s", names[i].c_str());
+    }
+
+    names = registry->getNames(true);
+    printf("\nMultithreaded sorts:");
+    for (uint_t i = 0; i < names.size(); i++)
+    {
+        printf(" %s", names[i].c_str());
+    }
+
+    printf("\nDistributions:");
+    for (int dist = DISTRIBUTION_UNIFORM; dist <= DISTRIBUTION_QUICKSORT_KILLER; dist++)
+    {
+        printf(" %s", getDistributionName((data_dist_t)dist));
+    }
+    printf("\n");
+}
+
+/*
+Splits text separated with provided character. Empty parts are skipped.
+*/
+static std::vector<std::string> strSplit(std::string text, char separator)
+{
+    std::vector<std::string> parts;
+    size_t start = 0;
+
+    while (start <= text.length())
+    {
+        size_t end = text.find(separator, start);
+        if (end == std::string::npos)
+        {
+            end = text.length();
+        }
+
+        if (end > start)
+        {
+            parts.push_back(text.substr(start, end - start));
+        }
+        start = end + 1;
+    }
+
+    return parts;
+}
+
+/*
+Parses unsigned number of command line option. Exits if text isn't a number.
+*/
+static uint64_t parseNumber(std::string text, const char *optionName)
+{
+    char *end;
+    uint64_t value = strtoull(text.c_str(), &end, 10);
+
+    if (text.empty() || *end != '\0')
+    {
+        printf("Invalid value '%s' of %s.\n", text.c_str(), optionName);
+        exit(EXIT_FAILURE);
+    }
+
+    return value;
+}
+
+/*
+Returns distribution with provided name.
+*/
+static data_dist_t parseDistribution(std::string name)
+{
+    for (int dist = DISTRIBUTION_UNIFORM; dist <= DISTRIBUTION_QUICKSORT_KILLER; dist++)
+    {
+        if (name == getDistributionName((data_dist_t)dist))
+        {
+            return (data_dist_t)dist;
+        }
+    }
+
+    printf("Invalid distribution '%s'.\n", name.c_str());
+    exit(EXIT_FAILURE);
+    return DISTRIBUTION_UNIFORM;
+}
+
+/*
+Returns cache mode with provided name.
+*/
+static cache_mode_t parseCacheMode(std::string name)
+{
+    for (int cache = CACHE_WARM; cache <= CACHE_PAGE_COLD; cache++)
+    {
+        if (name == getCacheModeName((cache_mode_t)cache))
+        {
+            return (cache_mode_t)cache;
+        }
+    }
+
+    printf("Invalid cache mode '%s'.\n", name.c_str());
+    exit(EXIT_FAILURE);
+    return CACHE_WARM;
+}
+
+/*
+Generates array lengths from interval [start, end]. Between every two consecutive powers of 2 "split" lengths are
+tested (powers of 2 and equally spaced lengths between them), same as in "GenerateStatistics/statistics.py".
+*/
+static std::vector<uint_t> generateArrayLengths(uint_t start, uint_t end, uint_t split)
+{
+    std::vector<uint_t> arrayLengths;
+    arrayLengths.push_back(start);
+
+    for (uint64_t power = previousPowerOf2(start); power <= end; power *= 2)
+    {
+        uint64_t step = (std::max)(power / split, (uint64_t)1);
+
+        for (uint64_t length = power; length < 2 * power && length <= end; length += step)
+        {
+            if (length > arrayLengths.back())
+            {
+                arrayLengths.push_back((uint_t)length);
+            }
+        }
+    }
+
+    if (end > arrayLengths.back())
+    {
+        arrayLengths.push_back(end);
+    }
+
+    return arrayLengths;
+}
+
+/*
+Parses array length or range of array lengths in format "START[:END[:SPLIT]]".
+*/
+static std::vector<uint_t> parseArrayLengths(std::string text)
+{
+    std::vector<std::string> parts = strSplit(text, ':');
+
+    if (parts.size() < 1 || parts.size() > 3)
+    {
+        printf("Invalid array length '%s'.\n", text.c_str());
+        exit(EXIT_FAILURE);
+    }
+
+    uint_t start = (uint_t)parseNumber(parts[0], "array length");
+    uint_t end = parts.size() > 1 ? (uint_t)parseNumber(parts[1], "array length") : start;
+    uint_t split = parts.size() > 2 ? (uint_t)parseNumber(parts[2], "array length") : BENCHMARK_DEFAULT_LENGTH_SPLIT;
+
+    if (start == 0 || end < start || split == 0)
+    {
+        printf("Invalid array length '%s'.\n", text.c_str());
+        exit(EXIT_FAILURE);
+    }
+
+    return generateArrayLengths(start, end, split);
+}
+
+/*
+Returns default numbers of threads for scaling test: powers of 2 up to number of CPUs and number of CPUs.
+*/
+static std::vector<uint_t> getDefaultThreadCounts()
+{
+    std::vector<uint_t> threadCounts;
+    uint_t numCpus = getNumThreads();
+
+    for (uint_t numThreads = 1; numThreads < numCpus; numThreads *= 2)
+    {
+        threadCounts.push_back(numThreads);
+    }
+    threadCounts.push_back(numCpus);
+
+    return threadCounts;
+}
+
+/*
+Measures memory bandwidth with STREAM kernels for provided number of threads and prints it. Results are cached, so
+bandwidth isn't measured again during tests.
+*/
+static void printStreamBandwidth(uint_t numThreads)
+{
+    if (!BENCHMARK_MEASURE_BANDWIDTH)
+    {
+        return;
+    }
+
+    stream_bandwidth_t bandwidth = getStreamBandwidth(numThreads);
+    printf("> Memory bandwidth (STREAM, %u threads):", numThreads);
+
+    for (uint_t kernel = 0; kernel < STREAM_KERNELS_NUM; kernel++)
+    {
+        printf(" %s %.2lf", getStreamKernelName((stream_kernel_t)kernel), bandwidth.kernels[kernel]);
+    }
+    printf(" GB/s (peak %.2lf GB/s)\n", bandwidth.peak);
+}
+
+/*
+Parses command line, constructs requested sorts and tests them for all requested distributions, array lengths and
+sort modes (key-only, key-value) in one process.
+*/
+int runBenchmark(int argc, char **argv, SortRegistry *registry)
+{
+    std::vector<std::string> sortNames = registry->getNames();
+    // Input data distributions
+    std::vector<data_dist_t> distributions;
+    distributions.push_back(DISTRIBUTION_UNIFORM);
+    distributions.push_back(DISTRIBUTION_GAUSSIAN);
+    distributions.push_back(DISTRIBUTION_ZERO);
+    distributions.push_back(DISTRIBUTION_BUCKET);
+    distributions.push_back(DISTRIBUTION_SORTED_ASC);
+    distributions.push_back(DISTRIBUTION_SORTED_DESC);
+    distributions.push_back(DISTRIBUTION_ZIPF);
+    distributions.push_back(DISTRIBUTION_FEW_UNIQUE);
+    distributions.push_back(DISTRIBUTION_NEARLY_SORTED);
+    distributions.push_back(DISTRIBUTION_SORTED_TAIL);
+    distributions.push_back(DISTRIBUTION_ORGAN_PIPE);
+    distributions.push_back(DISTRIBUTION_SAWTOOTH);
+    distributions.push_back(DISTRIBUTION_QUICKSORT_KILLER);
+
+    std::vector<uint_t> arrayLengths;
+    // How many times is the sorting algorithm test repeated
+    uint_t testRepetitions = BENCHMARK_DEFAULT_REPETITIONS;
+    // Sort order of the data
+    order_t sortOrder = ORDER_ASC;
+    // Seed of input data. Repetition "i" sorts data generated with seed "seed + i".
+    uint64_t seed = generateSeed();
+    // Datasets are saved to files (and reused by later runs) only if seed is provided, because generated seeds are
+    // never repeated
+    bool seedSelected = false;
+    // Interval of input data -> [0, "interval]
+    uint_t interval = MAX_VAL;
+    bool testKeyOnly = true, testKeyValue = true;
+    std::vector<uint_t> threadCounts;
+    std::vector<scaling_mode_t> scalingModes;
+    std::vector<cache_mode_t> cacheModes(1, CACHE_WARM);
+    bool sortsSelected = false;
+    uint_t numPositional = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string argument = argv[i];
+        size_t separator = argument.find('=');
+        std::string option = argument.substr(0, separator);
+        std::string value = separator == std::string::npos ? "" : argument.substr(separator + 1);
+
+        if (argument.compare(0, 2, "--") != 0)
+        {
+            // Positional arguments: array length, number of test repetitions, sort order, seed
+            switch (numPositional++)
+            {
+                case 0: arrayLengths = parseArrayLengths(argument); break;
+                case 1: testRepetitions = (uint_t)parseNumber(argument, "number of test repetitions"); break;
+                case 2: sortOrder = (order_t)parseNumber(argument, "sort order"); break;
+                case 3: seed = parseNumber(argument, "seed"); seedSelected = true; break;
+                default:
+                    printf("Too many positional arguments.\n");
+                    exit(EXIT_FAILURE);
+            }
+        }
+        else if (option == "--sorts")
+        {
+            sortNames = strSplit(value, ',');
+            sortsSelected = true;
+            for (uint_t s = 0; s < sortNames.size(); s++)
+            {
+                if (!registry->contains(sortNames[s]))
+                {
+                    printf("Sort '%s' is not registered. Use --list to print available sorts.\n", sortNames[s].c_str());
+                    exit(EXIT_FAILURE);
+                }
+            }
+        }
+        else if (option == "--distributions")
+        {
+            std::vector<std::string> names = strSplit(value, ',');
+            distributions.clear();
+            for (uint_t d = 0; d < names.size(); d++)
+            {
+                distributions.push_back(parseDistribution(names[d]));
+            }
+        }
+        else if (option == "--mode" && (value == "key-only" || value == "key-value" || value == "both"))
+        {
+            testKeyOnly = value != "key-value";
+            testKeyValue = value != "key-only";
+        }
+        else if (option == "--length")
+        {
+            arrayLengths = parseArrayLengths(value);
+        }
+        else if (option == "--repetitions")
+        {
+            testRepetitions = (uint_t)parseNumber(value, option.c_str());
+        }
+        else if (option == "--order" && (value == "asc" || value == "desc"))
+        {
+            sortOrder = value == "asc" ? ORDER_ASC : ORDER_DESC;
+        }
+        else if (option == "--seed")
+        {
+            seed = parseNumber(value, option.c_str());
+            seedSelected = true;
+        }
+        else if (option == "--threads")
+        {
+            std::vector<std::string> counts = strSplit(value, ',');
+            threadCounts.clear();
+            for (uint_t t = 0; t < counts.size(); t++)
+            {
+                threadCounts.push_back((uint_t)parseNumber(counts[t], option.c_str()));
+                if (threadCounts.back() == 0 || (t > 0 && threadCounts[t] <= threadCounts[t - 1]))
+                {
+                    printf("Numbers of threads have to be greater than 0 and in ascending order.\n");
+                    exit(EXIT_FAILURE);
+                }
+            }
+        }
+        else if (option == "--scaling" && (value == "strong" || value == "weak" || value == "both"))
+        {
+            scalingModes.clear();
+            if (value != "weak")
+            {
+                scalingModes.push_back(SCALING_STRONG);
+            }
+            if (value != "strong")
+            {
+                scalingModes.push_back(SCALING_WEAK);
+            }
+        }
+        else if (option == "--cache")
+        {
+            std::vector<std::string> names = strSplit(value, ',');
+            cacheModes.clear();
+            for (uint_t c = 0; c < names.size(); c++)
+            {
+                cacheModes.push_back(parseCacheMode(names[c]));
+            }
+        }
+        else if (option == "--list" || option == "--help")
+        {
+            printUsage(registry);
+            return 0;
+        }
+        else
+        {
+            printf("Invalid argument '%s'.\n", argument.c_str());
+            printUsage(registry);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    if (!scalingModes.empty() && (cacheModes.size() != 1 || cacheModes[0] != CACHE_WARM))
+    {
+        printf("Scaling test is executed only with warm caches (--cache=warm).\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (!scalingModes.empty())
+    {
+        // Scaling test is executed only for multithreaded sorts, unless sorts are selected explicitly
+        if (!sortsSelected)
+        {
+            sortNames = registry->getNames(true);
+        }
+        if (threadCounts.empty())
+        {
+            threadCounts = getDefaultThreadCounts();
+        }
+    }
+    else if (threadCounts.size() > 1)
+    {
+        printf("Multiple numbers of threads can be specified only in scaling test (--scaling).\n");
+        exit(EXIT_FAILURE);
+    }
+    else if (threadCounts.size() == 1)
+    {
+        setNumThreads(threadCounts[0]);
+    }
+
+    if (arrayLengths.empty() || testRepetitions == 0 || sortNames.empty() || distributions.empty() ||
+        cacheModes.empty())
+    {
+        printf(
+            "Array length, number of test repetitions, sorts, distributions and cache modes have to be "
+            "specified.\n"
+        );
+        printUsage(registry);
+        exit(EXIT_FAILURE);
+    }
+
+    // Only requested sorts are constructed
+    std::vector<SortSequential*> sorts;
+    for (uint_t i = 0; i < sortNames.size(); i++)
+    {
+        SortSequential *sort = registry->create(sortNames[i]);
+
+        // Memory management isn't timed. For parallel sorts this is needed only for testing purposes, because
+        // data transfer from device to host shouldn't be timed.
+        sort->stopwatchEnable();
+        if (BENCHMARK_PERF_COUNTERS)
+        {
+            sort->perfCountersEnable();
+        }
+
+        sorts.push_back(sort);
+    }
+
+    if (BENCHMARK_CPU_INDEX >= 0)
+    {
+        // Worker threads are created before pinning, otherwise they would inherit affinity of benchmark thread. All
+        // workers needed by the largest number of threads (in scaling test) are created.
+        uint_t maxNumThreads = getNumThreads();
+        if (!threadCounts.empty())
+        {
+            maxNumThreads = (std::max)(maxNumThreads, threadCounts.back());
+        }
+        parallelFor(maxNumThreads, [](uint_t) {});
+
+        if (!pinThreadToCpu(BENCHMARK_CPU_INDEX))
+        {
+            printf("Benchmark thread couldn't be pinned to CPU %d.\n", BENCHMARK_CPU_INDEX);
+        }
+    }
+
+    printf("> Timer: %s (resolution %.2lf ns)\n", getTimerSourceName(), getTimerResolution());
+    printFrequencyScalingWarnings();
+    if (BENCHMARK_PERF_COUNTERS)
+    {
+        printf("> Performance counters:");
+        for (uint_t counter = 0; counter < PERF_COUNTERS_NUM; counter++)
+        {
+            bool isAvailable = isPerfCounterAvailable((perf_counter_t)counter);
+            printf(" %s (%s)", getPerfCounterName((perf_counter_t)counter), isAvailable ? "yes" : "no");
+        }
+        printf("\n");
+    }
+    if (scalingModes.empty())
+    {
+        printf("> Threads: %u\n", getNumThreads());
+        printStreamBandwidth(getNumThreads());
+    }
+    else
+    {
+        printf("> Scaling test (threads:");
+        for (uint_t i = 0; i < threadCounts.size(); i++)
+        {
+            printf(" %u", threadCounts[i]);
+        }
+        printf(")\n");
+        for (uint_t i = 0; i < threadCounts.size(); i++)
+        {
+            printStreamBandwidth(threadCounts[i]);
+        }
+    }
+    printf("> Array lengths:");
+    for (uint_t i = 0; i < arrayLengths.size(); i++)
+    {
+        printf(" %u", arrayLengths[i]);
+    }
+    printf("\n> Cache modes:");
+    for (uint_t i = 0; i < cacheModes.size(); i++)
+    {
+        printf(" %s", getCacheModeName(cacheModes[i]));
+    }
+    printf("\n> Seed: %llu%s\n\n", (unsigned long long)seed, seedSelected ? " (datasets are saved)" : "");
+
+    if (scalingModes.empty())
+    {
+        generateStatistics(
+            sorts, distributions, arrayLengths, cacheModes, sortOrder, testRepetitions, interval, seed, seedSelected,
+            testKeyOnly, testKeyValue
+        );
+    }
+    else
+    {
+        generateScalingStatistics(
+            sorts, distributions, arrayLengths, threadCounts, scalingModes, sortOrder, testRepetitions, interval,
+            seed, seedSelected, testKeyOnly, testKeyValue
+        );
+    }
+
+    for (uint_t i = 0; i < sorts.size(); i++)
+    {
+        delete sorts[i];
+    }
+
+    return 0;
+}
@@ -0,0 +1,9 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include "sort_registry.h"
+
+
+int runBenchmark(int argc, char **argv, SortRegistry *registry);
+
+#endif
@@ -0,0 +1,366 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+#include <vector>
+#include <string>
+#include <map>
+#include <fstream>
+
+#include "../Utils/data_types_common.h"
+#include "../Utils/statistics.h"
+#include "constants.h"
+
+
+/*
+One record of result file. Records contain only strings, numbers (booleans and null are converted to numbers) and
+arrays of numbers. Nested objects (performance counters) are skipped.
+*/
+struct ResultRecord
+{
+    std::map<std::string, std::string> strings;
+    std::map<std::string, double> numbers;
+    std::map<std::string, std::vector<double>> arrays;
+};
+
+/*
+Minimal parser of JSON objects written by benchmark.
+*/
+class RecordParser
+{
+private:
+    const char *_text;
+    uint_t _position;
+
+    void skipSpaces()
+    {
+        while (isspace(_text[_position]))
+        {
+            _position++;
+        }
+    }
+
+    void expect(char character)
+    {
+        skipSpaces();
+        if (_text[_position] != character)
+        {
+            printf("Invalid result record, expected '%c' at position %u.\n", character, _position);
+            exit(EXIT_FAILURE);
+        }
+        _position++;
+    }
+
+    std::string parseString()
+    {
+        std::string text;
+        expect('"');
+
+        while (_text[_position] != '"' && _text[_position] != '\0')
+        {
+            if (_text[_position] == '\\')
+            {
+                _position++;
+            }
+            text += _text[_position++];
+        }
+
+        expect('"');
+        return text;
+    }
+
+    double parseNumber()
+    {
+        skipSpaces();
+
+        if (strncmp(_text + _position, "true", 4) == 0 || strncmp(_text + _position, "null", 4) == 0)
+        {
+            double value = _text[_position] == 't' ? 1 : -1;
+            _position += 4;
+            return value;
+        }
+        if (strncmp(_text + _position, "false", 5) == 0)
+        {
+            _position += 5;
+            return 0;
+        }
+
+        char *end;
+        double value = strtod(_text + _position, &end);
+        if (end == _text + _position)
+        {
+            printf("Invalid result record, expected number at position %u.\n", _position);
+            exit(EXIT_FAILURE);
+        }
+
+        _position = end - _text;
+        return value;
+    }
+
+    std::vector<double> parseArray()
+    {
+        std::vector<double> values;
+        expect('[');
+        skipSpaces();
+
+        while (_text[_position] != ']')
+        {
+            values.push_back(parseNumber());
+            skipSpaces();
+            if (_text[_position] == ',')
+            {
+                _position++;
+            }
+            skipSpaces();
+        }
+
+        expect(']');
+        return values;
+    }
+
+    /*
+    Parses object. If "record" is NULL, object is skipped.
+    */
+    void parseObject(ResultRecord *record)
+    {
+        expect('{');
+        skipSpaces();
+
+        while (_text[_position] != '}')
+        {
+            std::string key = parseString();
+            expect(':');
+            skipSpaces();
+
+            if (_text[_position] == '"')
+            {
+                std::string value = parseString();
+                if (record != NULL)
+                {
+                    record->strings[key] = value;
+                }
+            }
+            else if (_text[_position] == '[')
+            {
+                std::vector<double> values = parseArray();
+                if (record != NULL)
+                {
+                    record->arrays[key] = values;
+                }
+            }
+            else if (_text[_position] == '{')
+            {
+                parseObject(NULL);
+            }
+            else
+            {
+                double value = parseNumber();
+                if (record != NULL)
+                {
+                    record->numbers[key] = value;
+                }
+            }
+
+            skipSpaces();
+            if (_text[_position] == ',')
+            {
+                _position++;
+            }
+            skipSpaces();
+        }
+
+        expect('}');
+    }
+
+public:
+    ResultRecord parse(std::string line)
+    {
+        ResultRecord record;
+        _text = line.c_str();
+        _position = 0;
+
+        parseObject(&record);
+        return record;
+    }
+};
+
+/*
+Returns cache mode of record. Records written before cache modes were introduced were measured with warm caches.
+*/
+std::string getRecordCacheMode(ResultRecord &record)
+{
+    return record.strings["cache"].empty() ? "warm" : record.strings["cache"];
+}
+
+/*
+Returns key, which identifies the same test in both result files.
+*/
+std::string getRecordKey(ResultRecord &record)
+{
+    return record.strings["sort"] + " " + record.strings["mode"] + " " + record.strings["distribution"] + " " +
+        std::to_string((uint64_t)record.numbers["array_length"]) + " " + record.strings["order"] + " " +
+        getRecordCacheMode(record) + " " + std::to_string((uint64_t)record.numbers["threads"]);
+}
+
+/*
+Reads result file. If the same test is contained in file more than once (file is appended by every run), the
+last record is used. Keys are returned in order of appearance.
+*/
+void readResultFile(
+    std::string fileName, std::map<std::string, ResultRecord> &records, std::vector<std::string> &keys
+)
+{
+    std::ifstream file(fileName);
+    if (!file.is_open())
+    {
+        printf("Result file '%s' couldn't be opened.\n", fileName.c_str());
+        exit(EXIT_FAILURE);
+    }
+
+    RecordParser parser;
+    std::string line;
+
+    while (std::getline(file, line))
+    {
+        if (line.find('{') == std::string::npos)
+        {
+            continue;
+        }
+
+        ResultRecord record = parser.parse(line);
+        std::string key = getRecordKey(record);
+
+        if (records.find(key) == records.end())
+        {
+            keys.push_back(key);
+        }
+        records[key] = record;
+    }
+}
+
+/*
+Prints description of machine and build of result file and warns, if results come from different machines.
+*/
+void printSystemInfo(ResultRecord &baseline, ResultRecord &candidate)
+{
+    const char *fields[] = { "cpu_model", "compiler", "compiler_flags", "git_commit" };
+
+    for (uint_t i = 0; i < sizeof(fields) / sizeof(*fields); i++)
+    {
+        printf(
+            "> %s: '%s' -> '%s'\n", fields[i], baseline.strings[fields[i]].c_str(),
+            candidate.strings[fields[i]].c_str()
+        );
+    }
+    printf("> threads: %.0lf -> %.0lf\n", baseline.numbers["threads"], candidate.numbers["threads"]);
+
+    if (baseline.strings["cpu_model"] != candidate.strings["cpu_model"] ||
+        baseline.numbers["num_cpus"] != candidate.numbers["num_cpus"] ||
+        baseline.numbers["threads"] != candidate.numbers["threads"])
+    {
+        printf("> WARNING: results were measured on different machines or with different number of threads.\n");
+    }
+    printf("\n");
+}
+
+/*
+Compares two result files written by benchmark (see "writeResultToStream") and reports statistically significant
+slowdowns and speedups of sorts, which were tested in both files. Exits with code 1 if any sort is slower or
+incorrect, so it can be used as a gate.
+*/
+int main(int argc, char **argv)
+{
+    double significanceLevel = COMPARE_SIGNIFICANCE_LEVEL;
+    double minRelativeChange = COMPARE_MIN_RELATIVE_CHANGE;
+    std::vector<std::string> fileNames;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strncmp(argv[i], "--alpha=", 8) == 0)
+        {
+            significanceLevel = atof(argv[i] + 8);
+        }
+        else if (strncmp(argv[i], "--threshold=", 12) == 0)
+        {
+            minRelativeChange = atof(argv[i] + 12);
+        }
+        else
+        {
+            fileNames.push_back(argv[i]);
+        }
+    }
+
+    if (fileNames.size() != 2)
+    {
+        printf(
+            "Usage: sort_compare BASELINE CANDIDATE [--alpha=P] [--threshold=RELATIVE_CHANGE]\nReports sorts, which "
+            "median time changed by more than threshold (default %.2lf) with p-value of Mann-Whitney U test below "
+            "alpha (default %.2lf).\nExits with code 1 if any sort is slower or incorrect.\n",
+            COMPARE_MIN_RELATIVE_CHANGE, COMPARE_SIGNIFICANCE_LEVEL
+        );
+        exit(EXIT_FAILURE);
+    }
+
+    std::map<std::string, ResultRecord> baselineRecords, candidateRecords;
+    std::vector<std::string> baselineKeys, candidateKeys;
+    readResultFile(fileNames[0], baselineRecords, baselineKeys);
+    readResultFile(fileNames[1], candidateRecords, candidateKeys);
+
+    if (!baselineKeys.empty() && !candidateKeys.empty())
+    {
+        printSystemInfo(baselineRecords[baselineKeys[0]], candidateRecords[candidateKeys[0]]);
+    }
+
+    uint_t numCompared = 0, numSlower = 0, numFaster = 0, numIncorrect = 0;
+
+    printf(
+        "%-40s %-9s %-16s %10s %-9s %7s %12s %12s %9s %10s\n", "SORT", "MODE", "DISTRIBUTION", "LENGTH", "CACHE",
+        "THREADS", "BASE [ms]", "NEW [ms]", "CHANGE", "P-VALUE"
+    );
+
+    for (uint_t i = 0; i < candidateKeys.size(); i++)
+    {
+        if (baselineRecords.find(candidateKeys[i]) == baselineRecords.end())
+        {
+            continue;
+        }
+
+        ResultRecord &baseline = baselineRecords[candidateKeys[i]];
+        ResultRecord &candidate = candidateRecords[candidateKeys[i]];
+        std::vector<double> &baselineTimes = baseline.arrays["times_ms"];
+        std::vector<double> &candidateTimes = candidate.arrays["times_ms"];
+
+        double baselineMedian = computePercentile(baselineTimes, 0.5);
+        double candidateMedian = computePercentile(candidateTimes, 0.5);
+        double relativeChange = baselineMedian > 0 ? candidateMedian / baselineMedian - 1 : 0;
+        double pValue = mannWhitneyPValue(baselineTimes, candidateTimes);
+        bool isSignificant = pValue < significanceLevel && fabs(relativeChange) > minRelativeChange;
+        const char *verdict = !isSignificant ? "" : (relativeChange > 0 ? "SLOWER" : "FASTER");
+
+        numCompared++;
+        numSlower += isSignificant && relativeChange > 0;
+        numFaster += isSignificant && relativeChange < 0;
+
+        printf(
+            "%-40s %-9s %-16s %10.0lf %-9s %7.0lf %12.3lf %12.3lf %+8.1lf%% %10.2e %s\n",
+            candidate.strings["sort"].c_str(), candidate.strings["mode"].c_str(),
+            candidate.strings["distribution"].c_str(), candidate.numbers["array_length"],
+            getRecordCacheMode(candidate).c_str(), candidate.numbers["threads"], baselineMedian, candidateMedian,
+            relativeChange * 100, pValue, verdict
+        );
+
+        if (baseline.numbers["correct"] == 1 && candidate.numbers["correct"] == 0)
+        {
+            printf("> ERROR: sort isn't correct in candidate results.\n");
+            numIncorrect++;
+        }
+    }
+
+    printf(
+        "\n> Compared: %u, slower: %u, faster: %u, incorrect: %u (alpha %.3lf, threshold %.1lf%%)\n", numCompared,
+        numSlower, numFaster, numIncorrect, significanceLevel, minRelativeChange * 100
+    );
+
+    return numSlower > 0 || numIncorrect > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
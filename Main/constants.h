@@ -4,12 +4,22 @@
 
 /* ---------------------- FOLDERS -------------------- */
 
-// Folder where all statistics and temporary files are saved. This is the root folder.
+// Folder where all statistics and input datasets are saved. This is the root folder.
 #define FOLDER_SORT_ROOT "../SortStatistics/"
-// Temporary folder, where unsorted and sorted arrays are saved into file (currently not used).
-#define FOLDER_SORT_TEMP FOLDER_SORT_ROOT "SortTemp/"
+// Folder, where generated input data is saved into binary files, so it can be reused by all sorts.
+#define FOLDER_SORT_DATASETS FOLDER_SORT_ROOT "Datasets/"
 // Folder, where sort execution times are saved.
 #define FOLDER_SORT_TIMERS FOLDER_SORT_ROOT "Time/"
+// Folder, where seeds of input data are saved (on the same positions as sort execution times).
+#define FOLDER_SORT_SEEDS FOLDER_SORT_ROOT "Seed/"
+// Folder, where hardware performance counters of sorts are saved (per element, on the same positions as times).
+#define FOLDER_SORT_COUNTERS FOLDER_SORT_ROOT "Counters/"
+// Folder, where timelines of sort phases are saved as Chrome traces (only if TRACE_ENABLED is true).
+#define FOLDER_SORT_TRACES FOLDER_SORT_ROOT "Trace/"
+// Folder, where robust statistics of sort times are saved (one line per array length, see "writeSummaryToFile").
+#define FOLDER_SORT_SUMMARY FOLDER_SORT_ROOT "Summary/"
+// Folder, where scalability of multithreaded sorts is saved (one file per sort and scaling mode).
+#define FOLDER_SORT_SCALING FOLDER_SORT_ROOT "Scaling/"
 // Folder, where sort correctness statuses are saved.
 #define FOLDER_SORT_CORRECTNESS FOLDER_SORT_ROOT "Correctness/"
 // Folder, where sort stability statuses are saved.
@@ -26,11 +36,49 @@
 #define FILE_SEPARATOR_CHAR "\t"
 // New line character in file
 #define FILE_NEW_LINE_CHAR "\n"
-// File where unsorted array is saved (currently not used).
-#define FILE_UNSORTED_ARRAY FOLDER_SORT_TEMP "array_unsorted"
-// File where correctly sorted array is saved (currently not used).
-#define FILE_SORTED_ARRAY FOLDER_SORT_TEMP "array_sorted"
 // File where all array lengths are saved.
 #define FILE_ARRAY_LENGTHS FOLDER_SORT_ROOT "array_lengths" FILE_EXTENSION
+// File where results of all sorts are saved together with description of machine and build (one JSON object per
+// line, see "writeResultToStream"). Results from different runs can be compared with "sort_compare".
+#define FILE_RESULTS FOLDER_SORT_ROOT "results.jsonl"
+
+
+/* --------------------- BENCHMARK ------------------- */
+
+// Number of test repetitions of every sort, if it isn't specified on command line.
+#define BENCHMARK_DEFAULT_REPETITIONS 10
+// Number of array lengths tested between 2^n and 2^(n + 1), if range of array lengths is specified on command line
+// without this number.
+#define BENCHMARK_DEFAULT_LENGTH_SPLIT 2
+// Index of CPU, to which the benchmark thread is pinned during testing. If negative, thread isn't pinned.
+#define BENCHMARK_CPU_INDEX -1
+// Denotes if hardware performance counters (perf_event_open, Linux only) are measured during sorts. Counters,
+// which aren't supported by CPU, kernel or permissions (perf_event_paranoid), are reported as unavailable.
+#define BENCHMARK_PERF_COUNTERS 1
+// Number of warm-up repetitions executed before measured repetitions of every sort. Their results aren't saved.
+#define BENCHMARK_WARMUP_REPETITIONS 1
+// If true, sort is repeated after requested number of repetitions, until confidence interval of median time is
+// narrow enough (BENCHMARK_CI_RELATIVE_WIDTH) or until BENCHMARK_MAX_REPETITIONS is reached.
+#define BENCHMARK_ADAPTIVE_REPETITIONS 0
+// Maximum number of repetitions in adaptive mode.
+#define BENCHMARK_MAX_REPETITIONS 100
+// Requested width of confidence interval of median time relative to median time in adaptive mode.
+#define BENCHMARK_CI_RELATIVE_WIDTH 0.02
+// Confidence level of confidence interval of median time.
+#define BENCHMARK_CONFIDENCE_LEVEL 0.95
+// Number of bootstrap resamples used to compute confidence interval of median time.
+#define BENCHMARK_BOOTSTRAP_SAMPLES 1000
+// Denotes if memory bandwidth is measured with STREAM kernels (once for every number of threads). Achieved bandwidth
+// of sorts (according to their model of memory traffic) is reported relative to the best STREAM bandwidth.
+#define BENCHMARK_MEASURE_BANDWIDTH 1
+
+
+/* ---------------------- COMPARE -------------------- */
+
+// Significance level of Mann-Whitney U test, with which "sort_compare" decides if sort times differ.
+#define COMPARE_SIGNIFICANCE_LEVEL 0.01
+// Minimal relative change of median time, which is reported as slowdown or speedup. Smaller changes aren't
+// reported even if they are statistically significant.
+#define COMPARE_MIN_RELATIVE_CHANGE 0.05
 
 #endif
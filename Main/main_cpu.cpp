@@ -0,0 +1,43 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "../Utils/data_types_common.h"
+#include "../Utils/sort_interface.h"
+
+#include "../BitonicSort/Sort/sequential.h"
+#include "../BitonicSort/Sort/sequential_simd.h"
+#include "../BitonicSortMultistep/Sort/multithreaded.h"
+#include "../BitonicSortAdaptive/Sort/sequential.h"
+#include "../BitonicSortAdaptive/Sort/multithreaded.h"
+#include "../MergeSort/Sort/sequential.h"
+#include "../Quicksort/Sort/sequential.h"
+#include "../RadixSort/Sort/sequential.h"
+#include "../SampleSort/Sort/sequential.h"
+#include "../SampleSort/Sort/multithreaded.h"
+#include "../SampleSort/Sort/hybrid.h"
+#include "../SampleSortInPlace/Sort/multithreaded.h"
+
+#include "sort_registry.h"
+#include "benchmark.h"
+
+
+int main(int argc, char **argv)
+{
+    // Sorting algorithms, which can be selected on command line (only sequential and multithreaded CPU sorts)
+    SortRegistry registry;
+    registry.add<BitonicSortSequential>("bitonic_sequential");
+    registry.add<BitonicSortSequentialSimd>("bitonic_sequential_simd");
+    registry.add<BitonicSortMultistepMultithreaded>("bitonic_multistep_multithreaded", true);
+    registry.add<BitonicSortAdaptiveSequential>("bitonic_adaptive_sequential");
+    registry.add<BitonicSortAdaptiveMultithreaded>("bitonic_adaptive_multithreaded", true);
+    registry.add<MergeSortSequential>("merge_sequential");
+    registry.add<QuicksortSequential>("quicksort_sequential");
+    registry.add<RadixSortSequential>("radix_sequential");
+    registry.add<SampleSortSequential>("sample_sequential");
+    registry.add<SampleSortMultithreaded>("sample_multithreaded", true);
+    registry.add<SampleSortHybrid>("sample_hybrid");
+    registry.add<SampleSortInPlaceMultithreaded>("sample_in_place_multithreaded", true);
+
+    return runBenchmark(argc, argv, &registry);
+}
@@ -0,0 +1,100 @@
+#ifndef SORT_REGISTRY_H
+#define SORT_REGISTRY_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <functional>
+
+#include "../Utils/sort_interface.h"
+
+
+/*
+Sorts available to benchmark, keyed by name (used on command line). Only factories are stored, so sorts are
+constructed (and their memory allocated) only if they are selected. Multithreaded CPU sorts are marked, because
+only they are tested in scaling tests (number of threads is set with "setNumThreads" before sort is executed).
+*/
+class SortRegistry
+{
+private:
+    struct SortRegistryEntry
+    {
+        std::string name;
+        std::function<SortSequential*()> create;
+        bool isMultithreaded;
+    };
+
+    std::vector<SortRegistryEntry> _entries;
+
+    int findSort(std::string name)
+    {
+        for (uint_t i = 0; i < _entries.size(); i++)
+        {
+            if (_entries[i].name == name)
+            {
+                return i;
+            }
+        }
+
+        return -1;
+    }
+
+public:
+    /*
+    Registers sort with provided name. Sorts are listed and benchmarked in order of registration.
+    */
+    template <typename Sort>
+    void add(std::string name, bool isMultithreaded = false)
+    {
+        if (findSort(name) >= 0)
+        {
+            printf("Sort '%s' is already registered.\n", name.c_str());
+            exit(EXIT_FAILURE);
+        }
+
+        SortRegistryEntry entry = { name, []() -> SortSequential* { return new Sort(); }, isMultithreaded };
+        _entries.push_back(entry);
+    }
+
+    bool contains(std::string name)
+    {
+        return findSort(name) >= 0;
+    }
+
+    /*
+    Returns names of all registered sorts. If "onlyMultithreaded" is true, only multithreaded CPU sorts are returned.
+    */
+    std::vector<std::string> getNames(bool onlyMultithreaded = false)
+    {
+        std::vector<std::string> names;
+
+        for (uint_t i = 0; i < _entries.size(); i++)
+        {
+            if (!onlyMultithreaded || _entries[i].isMultithreaded)
+            {
+                names.push_back(_entries[i].name);
+            }
+        }
+
+        return names;
+    }
+
+    /*
+    Constructs new instance of sort with provided name. Caller is responsible for deleting it.
+    */
+    SortSequential* create(std::string name)
+    {
+        int index = findSort(name);
+
+        if (index < 0)
+        {
+            printf("Sort '%s' is not registered.\n", name.c_str());
+            exit(EXIT_FAILURE);
+        }
+
+        return _entries[index].create();
+    }
+};
+
+#endif
@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 #include <vector>
 #include <memory>
@@ -7,57 +8,111 @@
 #include <fstream>
 #include <iostream>
 
-#include <cuda.h>
-#include "cuda_runtime.h"
-#include "device_launch_parameters.h"
-
 #include "../Utils/data_types_common.h"
 #include "../Utils/sort_interface.h"
 #include "../Utils/host.h"
 #include "../Utils/file.h"
 #include "../Utils/generator.h"
-#include "../Utils/sort_correct.h"
+#include "../Utils/dataset.h"
+#include "../Utils/sort_verify.h"
+#include "../Utils/perf_counters.h"
+#include "../Utils/trace.h"
+#include "../Utils/statistics.h"
+#include "../Utils/system_info.h"
+#include "../Utils/threads.h"
+#include "../Utils/bandwidth.h"
+#include "../Utils/allocation.h"
+#include "../Utils/cache.h"
+#include "test_sort.h"
 #include "constants.h"
 
 
 /*
-Prints line in statistics table.
+Prints line in statistics table. If performance counters are measured, table contains additional columns.
 */
-void printTableLine()
+void printTableLine(bool perfCountersEnabled)
 {
-    printf("==================================================================\n");
+    printf("===========================================================================================");
+    if (perfCountersEnabled)
+    {
+        printf("=============================================================");
+    }
+    printf("\n");
 }
 
 /*
 Prints statistics table header.
 */
-void printTableHeader()
+void printTableHeader(bool perfCountersEnabled)
+{
+    printTableLine(perfCountersEnabled);
+    printf("|| #     ||      TIME     |    SORT RATE   || CORRECT || STABLE ||                 SEED ||");
+    if (perfCountersEnabled)
+    {
+        printf("   CYC/EL |   INS/EL | BR-MIS/EL | LLC-MIS/EL | TLB-MIS/EL ||");
+    }
+    printf("\n");
+    printTableLine(perfCountersEnabled);
+}
+
+/*
+Returns the value of performance counter per one sorted element or -1, if counter isn't available.
+*/
+double perfCounterPerElement(perf_counters_t *counters, perf_counter_t counter, uint_t arrayLength)
 {
-    printTableLine();
-    printf("|| #     ||      TIME     |    SORT RATE   || CORRECT || STABLE ||\n");
-    printTableLine();
+    if (!counters->isAvailable[counter])
+    {
+        return -1;
+    }
+
+    return (double)counters->values[counter] / arrayLength;
 }
 
 /*
-Prints sort statistics.
+Prints sort statistics. If performance counters aren't measured, then "counters" contains NULL.
 */
-void printSortStatistics(uint_t iteration, double time, uint_t arrayLength, int_t isCorrect, int_t isStable)
+void printSortStatistics(
+    uint_t iteration, double time, uint_t arrayLength, int_t isCorrect, int_t isStable, uint64_t seed,
+    perf_counters_t *counters
+)
 {
-    char *isCorrectOutput = isCorrect ? "YES" : "NO";
-    char *isStableOutput = isStable == -1 ? "/" : (isStable == 1 ? "YES" : "NO");
+    const char *isCorrectOutput = isCorrect ? "YES" : "NO";
+    const char *isStableOutput = isStable == -1 ? "/" : (isStable == 1 ? "YES" : "NO");
+    // Widths of performance counter columns
+    const int widths[PERF_COUNTERS_NUM] = { 8, 8, 9, 10, 10 };
 
     printf(
-        "|| %5d || %10.2lf ms | %10.2lf M/s ||    %3s  ||   %3s  ||\n", iteration + 1, time,
-        arrayLength / 1000.0 / time, isCorrectOutput, isStableOutput
+        "|| %5d || %10.2lf ms | %10.2lf M/s ||    %3s  ||   %3s  || %20llu ||", iteration + 1, time,
+        arrayLength / 1000.0 / time, isCorrectOutput, isStableOutput, (unsigned long long)seed
     );
+
+    if (counters != NULL)
+    {
+        for (uint_t counter = 0; counter < PERF_COUNTERS_NUM; counter++)
+        {
+            double value = perfCounterPerElement(counters, (perf_counter_t)counter, arrayLength);
+            const char *separator = counter == PERF_COUNTERS_NUM - 1 ? " ||" : " |";
+
+            if (value < 0)
+            {
+                printf(" %*s%s", widths[counter], "/", separator);
+            }
+            else
+            {
+                printf(" %*.3lf%s", widths[counter], value, separator);
+            }
+        }
+    }
+
+    printf("\n");
 }
 
 /*
 Folder path to specified distribution.
 */
-std::string folderPathDistribution(data_dist_t distribution)
+std::string folderPathDistribution(std::string folderName, data_dist_t distribution)
 {
-    std::string distFolderName(FOLDER_SORT_TIMERS);
+    std::string distFolderName(folderName);
     distFolderName += strCapitalize(getDistributionName(distribution));
     return distFolderName + "/";
 }
@@ -69,6 +124,15 @@ void createFolderStructure(std::vector<data_dist_t> distributions)
 {
     createFolder(FOLDER_SORT_ROOT);
     createFolder(FOLDER_SORT_TIMERS);
+    createFolder(FOLDER_SORT_SEEDS);
+    createFolder(FOLDER_SORT_COUNTERS);
+    createFolder(FOLDER_SORT_SUMMARY);
+    createFolder(FOLDER_SORT_SCALING);
+    if (TRACE_ENABLED)
+    {
+        createFolder(FOLDER_SORT_TRACES);
+    }
+    createFolder(FOLDER_SORT_DATASETS);
     createFolder(FOLDER_SORT_CORRECTNESS);
     createFolder(FOLDER_SORT_STABILITY);
     createFolder(FOLDER_SORT_CORRECTNESS FOLDER_LOG);
@@ -77,122 +141,242 @@ void createFolderStructure(std::vector<data_dist_t> distributions)
     // Creates a folder for every distribution, inside which creates a folder for data type.
     for (std::vector<data_dist_t>::iterator dist = distributions.begin(); dist != distributions.end(); dist++)
     {
-        createFolder(folderPathDistribution(*dist));
+        createFolder(folderPathDistribution(FOLDER_SORT_TIMERS, *dist));
+        createFolder(folderPathDistribution(FOLDER_SORT_SEEDS, *dist));
+        createFolder(folderPathDistribution(FOLDER_SORT_COUNTERS, *dist));
+        createFolder(folderPathDistribution(FOLDER_SORT_SUMMARY, *dist));
+        createFolder(folderPathDistribution(FOLDER_SORT_SCALING, *dist));
+        if (TRACE_ENABLED)
+        {
+            createFolder(folderPathDistribution(FOLDER_SORT_TRACES, *dist));
+        }
     }
 }
 
 /*
-Generates file name of unsorted array.
+Result of one repetition of sort.
 */
-std::string fileNameUnsortedArr(uint_t iteration)
+struct SortRepetition
 {
-    return std::string(FILE_UNSORTED_ARRAY) + "_" + std::to_string(iteration) + FILE_EXTENSION;
+    double time;
+    // Seed of input data
+    uint64_t seed;
+    bool isCorrect;
+    // Contains -1, if stability isn't tested (key-only sort)
+    int_t isStable;
+    perf_counters_t counters;
+    // Memory traffic of sort in bytes according to sort's model (0, if sort doesn't have a model)
+    double bytesMoved;
+};
+
+/*
+Returns the name of cache mode.
+*/
+const char* getCacheModeName(cache_mode_t cacheMode)
+{
+    switch (cacheMode)
+    {
+        case CACHE_WARM: return "warm";
+        case CACHE_COLD: return "cold";
+        case CACHE_PAGE_COLD: return "page-cold";
+        default: return "unknown";
+    }
 }
 
 /*
-Generates file name of sorted array.
+Returns the file name of sort (without extension). Results of cold and page-cold tests are saved to separate files,
+which have the name of cache mode appended.
 */
-std::string fileNameSortedArr(uint_t iteration)
+std::string fileNameSort(SortSequential *sort, bool sortingKeyOnly, cache_mode_t cacheMode)
 {
-    return std::string(FILE_SORTED_ARRAY) + '_' + std::to_string(iteration) + FILE_EXTENSION;
+    std::string fileName = strSlugify(sort->getSortName(sortingKeyOnly));
+    return cacheMode == CACHE_WARM ? fileName : fileName + "_" + getCacheModeName(cacheMode);
 }
 
 /*
-Checks if sorted values are unique.
-Not so trivial in some sorts - for example quicksort.
+Returns the file name of performance counter of sort.
 */
-void checkValuesUniqueness(data_t *values, uint_t arrayLength)
+std::string fileNamePerfCounter(
+    SortSequential *sort, perf_counter_t counter, bool sortingKeyOnly, cache_mode_t cacheMode
+)
 {
-    uint_t *uniquenessTable = (uint_t*)malloc(arrayLength * sizeof(*uniquenessTable));
+    std::string fileName = fileNameSort(sort, sortingKeyOnly, cacheMode) + "_";
+    return fileName + getPerfCounterName(counter) + FILE_EXTENSION;
+}
+
+/*
+Writes times of all repetitions to one line of file. Seeds of input data are written to seed file on the same
+positions, so every time can be reproduced.
+*/
+void writeTimesToFile(
+    SortSequential *sort, data_dist_t distribution, std::vector<SortRepetition> &repetitions, bool sortingKeyOnly,
+    cache_mode_t cacheMode
+)
+{
+    std::string fileName = fileNameSort(sort, sortingKeyOnly, cacheMode) + FILE_EXTENSION;
+    std::fstream file;
 
-    for (uint_t i = 0; i < arrayLength; i++)
+    file.open(folderPathDistribution(FOLDER_SORT_TIMERS, distribution) + fileName, std::fstream::app);
+    for (uint_t i = 0; i < repetitions.size(); i++)
     {
-        uniquenessTable[i] = 0;
+        file << (i == 0 ? "" : FILE_SEPARATOR_CHAR) << repetitions[i].time;
     }
+    file << FILE_NEW_LINE_CHAR;
+    file.close();
 
-    for (uint_t i = 0; i < arrayLength; i++)
+    file.open(folderPathDistribution(FOLDER_SORT_SEEDS, distribution) + fileName, std::fstream::app);
+    for (uint_t i = 0; i < repetitions.size(); i++)
     {
-        if (values[i] < 0 || values[i] > arrayLength - 1)
-        {
-            printf("Value out of range: %d\n", values[i]);
-            getchar();
-            exit(EXIT_FAILURE);
-        }
-        else if (++uniquenessTable[values[i]] > 1)
-        {
-            printf("Duplicate value: %d\n", values[i]);
-            getchar();
-            exit(EXIT_FAILURE);
-        }
+        file << (i == 0 ? "" : FILE_SEPARATOR_CHAR) << repetitions[i].seed;
     }
-
-    free(uniquenessTable);
+    file << FILE_NEW_LINE_CHAR;
+    file.close();
 }
 
 /*
-Determines if array is sorted in stable manner.
+Writes performance counters per element to files (one file per counter) on the same positions as times.
+Unavailable counters are written as -1.
 */
-bool isSortStable(data_t *keys, data_t *values, uint_t arrayLength)
+void writePerfCountersToFile(
+    SortSequential *sort, data_dist_t distribution, std::vector<SortRepetition> &repetitions, uint_t arrayLength,
+    bool sortingKeyOnly, cache_mode_t cacheMode
+)
 {
-    if (arrayLength == 1)
-    {
-        return true;
-    }
-
-    // Generally not needed
-    // checkValuesUniqueness(values, arrayLength);
+    std::string folderName = folderPathDistribution(FOLDER_SORT_COUNTERS, distribution);
+    std::fstream file;
 
-    for (uint_t i = 1; i < arrayLength; i++)
+    for (uint_t counter = 0; counter < PERF_COUNTERS_NUM; counter++)
     {
-        // For same keys, values have to be ordered in ascending order.
-        if (keys[i - 1] == keys[i] && values[i - 1] > values[i])
+        std::string fileName = fileNamePerfCounter(sort, (perf_counter_t)counter, sortingKeyOnly, cacheMode);
+        file.open(folderName + fileName, std::fstream::app);
+        for (uint_t i = 0; i < repetitions.size(); i++)
         {
-            return false;
+            file << (i == 0 ? "" : FILE_SEPARATOR_CHAR);
+            file << perfCounterPerElement(&repetitions[i].counters, (perf_counter_t)counter, arrayLength);
         }
+        file << FILE_NEW_LINE_CHAR;
+        file.close();
     }
-
-    return true;
 }
 
 /*
-Writes the time to file
+Writes statistics of sort times to file. Every line contains (for one array length): array length, number of
+repetitions, median, minimum, 90th percentile, 99th percentile, MAD, lower and upper bound of confidence
+interval of median. All times are in milliseconds.
 */
-void writeTimeToFile(
-    SortSequential *sort, data_dist_t distribution, double time, bool sortingKeyOnly, bool isLastTestRepetition
+void writeSummaryToFile(
+    SortSequential *sort, data_dist_t distribution, sample_statistics_t *statistics, uint_t arrayLength,
+    bool sortingKeyOnly, cache_mode_t cacheMode
 )
 {
-    std::string folderDistribution = folderPathDistribution(distribution);
-    std::string filePath = folderDistribution + strSlugify(sort->getSortName(sortingKeyOnly)) + FILE_EXTENSION;
+    std::string fileName = fileNameSort(sort, sortingKeyOnly, cacheMode) + FILE_EXTENSION;
     std::fstream file;
-    file.open(filePath, std::fstream::app);
-
-    file << time;
-    file << (isLastTestRepetition ? FILE_NEW_LINE_CHAR : FILE_SEPARATOR_CHAR);
 
+    file.open(folderPathDistribution(FOLDER_SORT_SUMMARY, distribution) + fileName, std::fstream::app);
+    file << arrayLength << FILE_SEPARATOR_CHAR << statistics->numSamples << FILE_SEPARATOR_CHAR;
+    file << statistics->median << FILE_SEPARATOR_CHAR << statistics->min << FILE_SEPARATOR_CHAR;
+    file << statistics->percentile90 << FILE_SEPARATOR_CHAR << statistics->percentile99 << FILE_SEPARATOR_CHAR;
+    file << statistics->mad << FILE_SEPARATOR_CHAR;
+    file << statistics->confidenceLower << FILE_SEPARATOR_CHAR << statistics->confidenceUpper;
+    file << FILE_NEW_LINE_CHAR;
     file.close();
 }
 
 /*
-Writes bolean to a file. Needed to write sort correctness and sort stability.
+Prints statistics of sort times below statistics table.
 */
-void writeBoleanToFile(
-    std::string folderName, bool val, SortSequential *sort, data_dist_t distribution, uint_t arrayLength,
-    order_t sortOrder, bool sortingKeyOnly
+void printSummary(sample_statistics_t *statistics)
+{
+    printf(
+        "> Median: %.3lf ms, min: %.3lf ms, p90: %.3lf ms, p99: %.3lf ms, MAD: %.3lf ms\n", statistics->median,
+        statistics->min, statistics->percentile90, statistics->percentile99, statistics->mad
+    );
+    printf(
+        "> %.0lf%% confidence interval of median: [%.3lf, %.3lf] ms (%u repetitions)\n",
+        BENCHMARK_CONFIDENCE_LEVEL * 100, statistics->confidenceLower, statistics->confidenceUpper,
+        statistics->numSamples
+    );
+}
+
+/*
+Returns peak memory bandwidth (GB/s) for current number of threads or 0, if bandwidth isn't measured.
+*/
+double getPeakBandwidth()
+{
+    return BENCHMARK_MEASURE_BANDWIDTH ? getStreamBandwidth(getNumThreads()).peak : 0;
+}
+
+/*
+Returns memory bandwidth (GB/s), which sort achieved in provided time (ms) according to its model of memory
+traffic, or 0, if sort doesn't have a model.
+*/
+double getAchievedBandwidth(double bytesMoved, double time)
+{
+    return time > 0 ? bytesMoved / time / 1e6 : 0;
+}
+
+/*
+Prints memory traffic of sort and bandwidth achieved in median time relative to peak bandwidth (STREAM). Model
+counts only main memory traffic, so passes over subarrays, which fit into last level cache, aren't counted.
+*/
+void printBandwidth(double bytesMoved, sample_statistics_t *statistics)
+{
+    if (bytesMoved <= 0)
+    {
+        printf("> Memory traffic: sort doesn't have a model of memory traffic\n");
+        return;
+    }
+
+    double bandwidth = getAchievedBandwidth(bytesMoved, statistics->median);
+    double peakBandwidth = getPeakBandwidth();
+
+    printf("> Memory traffic (model): %.1lf MB, bandwidth: %.2lf GB/s", bytesMoved / 1e6, bandwidth);
+    if (peakBandwidth > 0)
+    {
+        printf(" (%.1lf%% of peak %.2lf GB/s)", bandwidth / peakBandwidth * 100, peakBandwidth);
+    }
+    printf("\n");
+}
+
+/*
+Prints memory allocated by sort during test (input array isn't included): peak memory per element, number of
+allocations and time spent in allocations.
+*/
+void printAllocationStatistics(allocation_stats_t *allocationStatistics, uint_t arrayLength)
+{
+    printf(
+        "> Memory: peak %.2lf B/element (%.2lf MB), %llu allocations, allocation time %.3lf ms\n",
+        (double)allocationStatistics->peakBytes / arrayLength, allocationStatistics->peakBytes / 1e6,
+        (unsigned long long)allocationStatistics->numAllocations, allocationStatistics->allocationTime
+    );
+}
+
+/*
+Writes predicates (sort correctness or sort stability) of all repetitions to file.
+*/
+void writePredicatesToFile(
+    std::string folderName, std::vector<bool> predicates, SortSequential *sort, data_dist_t distribution,
+    uint_t arrayLength, order_t sortOrder, bool sortingKeyOnly, cache_mode_t cacheMode
 )
 {
-    std::string filePath = folderName + strSlugify(sort->getSortName(sortingKeyOnly)) + FILE_EXTENSION;
+    std::string filePath = folderName + fileNameSort(sort, sortingKeyOnly, cacheMode) + FILE_EXTENSION;
     std::fstream file;
+    bool allTrue = true;
 
-    // Outputs boolean
+    // Outputs booleans
     file.open(filePath, std::fstream::app);
-    file << val << FILE_SEPARATOR_CHAR;
+    for (uint_t i = 0; i < predicates.size(); i++)
+    {
+        file << predicates[i] << FILE_SEPARATOR_CHAR;
+        allTrue = allTrue && predicates[i];
+    }
     file.close();
 
-    // Prints log in case if boolean is false
-    if (!val)
+    // Prints log in case if any predicate is false
+    if (!allTrue)
     {
         std::string fileLog = folderName + FOLDER_LOG;
-        fileLog += strSlugify(sort->getSortName(sortingKeyOnly)) + FILE_EXTENSION;
+        fileLog += fileNameSort(sort, sortingKeyOnly, cacheMode) + FILE_EXTENSION;
 
         file.open(fileLog, std::fstream::app);
         file << getDistributionName(distribution) << " ";
@@ -204,127 +388,655 @@ void writeBoleanToFile(
 }
 
 /*
-Times sort with stopwatch, checks if sort is stable and checks if sort is ordering data correctly, than saves
-this statistics to file.
+Escapes quotes and backslashes in JSON string.
 */
-void testSort(
-    SortSequential *sort, data_dist_t distribution, data_t *keys, data_t *keysCopy, data_t *values,
-    uint_t arrayLength, order_t sortOrder, uint_t interval, uint_t iteration, uint_t testRepetitions,
-    bool sortingKeyOnly
+std::string jsonEscape(std::string text)
+{
+    std::string escaped;
+
+    for (uint_t i = 0; i < text.length(); i++)
+    {
+        if (text[i] == '"' || text[i] == '\\')
+        {
+            escaped += '\\';
+        }
+        escaped += text[i];
+    }
+
+    return escaped;
+}
+
+/*
+Returns number formatted for JSON or null, if number isn't valid.
+*/
+std::string jsonNumber(double value, bool isValid)
+{
+    if (!isValid)
+    {
+        return "null";
+    }
+
+    char text[64];
+    snprintf(text, sizeof(text), "%.6lf", value);
+    return text;
+}
+
+/*
+Appends one record (JSON object on one line) with all results of sort for one distribution and array length to
+result stream. Besides results it contains description of machine and build, so results can be compared by
+"sort_compare" tool.
+*/
+void writeResultToStream(
+    SortSequential *sort, data_dist_t distribution, std::vector<SortRepetition> &repetitions,
+    sample_statistics_t *statistics, allocation_stats_t *allocationStatistics, uint_t arrayLength,
+    order_t sortOrder, bool sortingKeyOnly, cache_mode_t cacheMode, system_info_t *systemInfo, uint64_t seed
 )
 {
-    // For every sort array is filled with new random values. It would be better if array was generated only
-    // once and saved to file, but this works much slower.
-    fillArrayKeyOnly(keys, arrayLength, interval, distribution);
-    std::copy(keys, keys + arrayLength, keysCopy);
+    FILE *file = fopen(FILE_RESULTS, "a");
+    if (file == NULL)
+    {
+        printf("Result file '%s' couldn't be opened.\n", FILE_RESULTS);
+        return;
+    }
+
+    fprintf(
+        file, "{\"sort\":\"%s\",\"mode\":\"%s\",\"distribution\":\"%s\",\"array_length\":%u,\"order\":\"%s\","
+        "\"cache\":\"%s\",\"repetitions\":%u", jsonEscape(sort->getSortName()).c_str(),
+        sortingKeyOnly ? "key_only" : "key_value", getDistributionName(distribution), arrayLength,
+        sortOrder == ORDER_ASC ? "asc" : "desc", getCacheModeName(cacheMode), (uint_t)repetitions.size()
+    );
+
+    bool isCorrect = true;
+    int_t isStable = repetitions.empty() ? -1 : repetitions[0].isStable;
+
+    fprintf(file, ",\"times_ms\":[");
+    for (uint_t i = 0; i < repetitions.size(); i++)
+    {
+        fprintf(file, "%s%.6lf", i == 0 ? "" : ",", repetitions[i].time);
+        isCorrect = isCorrect && repetitions[i].isCorrect;
+        isStable = isStable == -1 ? -1 : (isStable && repetitions[i].isStable);
+    }
+    fprintf(file, "],\"seeds\":[");
+    for (uint_t i = 0; i < repetitions.size(); i++)
+    {
+        fprintf(file, "%s%llu", i == 0 ? "" : ",", (unsigned long long)repetitions[i].seed);
+    }
+
+    fprintf(
+        file, "],\"correct\":%s,\"stable\":%s", isCorrect ? "true" : "false",
+        isStable == -1 ? "null" : (isStable ? "true" : "false")
+    );
+    fprintf(
+        file, ",\"median_ms\":%.6lf,\"min_ms\":%.6lf,\"p90_ms\":%.6lf,\"p99_ms\":%.6lf,\"mad_ms\":%.6lf,"
+        "\"ci_lower_ms\":%.6lf,\"ci_upper_ms\":%.6lf", statistics->median, statistics->min,
+        statistics->percentile90, statistics->percentile99, statistics->mad, statistics->confidenceLower,
+        statistics->confidenceUpper
+    );
+
+    // Medians of performance counters per element
+    fprintf(file, ",\"counters_per_element\":{");
+    for (uint_t counter = 0; counter < PERF_COUNTERS_NUM && sort->isPerfCountersEnabled(); counter++)
+    {
+        std::vector<double> values;
+        for (uint_t i = 0; i < repetitions.size(); i++)
+        {
+            double value = perfCounterPerElement(&repetitions[i].counters, (perf_counter_t)counter, arrayLength);
+            if (value >= 0)
+            {
+                values.push_back(value);
+            }
+        }
+
+        fprintf(file, "%s\"%s\":", counter == 0 ? "" : ",", getPerfCounterName((perf_counter_t)counter));
+        if (values.empty())
+        {
+            fprintf(file, "null");
+        }
+        else
+        {
+            fprintf(file, "%.6lf", computePercentile(values, 0.5));
+        }
+    }
+
+    // Memory traffic (model) and achieved bandwidth in median time
+    double bytesMoved = repetitions.empty() ? 0 : repetitions[0].bytesMoved;
+    double bandwidth = getAchievedBandwidth(bytesMoved, statistics->median);
+    double peakBandwidth = getPeakBandwidth();
+
+    fprintf(
+        file, "},\"bytes_moved\":%s,\"bandwidth_gbs\":%s,\"peak_bandwidth_gbs\":%s,\"bandwidth_peak_percent\":%s",
+        jsonNumber(bytesMoved, bytesMoved > 0).c_str(), jsonNumber(bandwidth, bytesMoved > 0).c_str(),
+        jsonNumber(peakBandwidth, peakBandwidth > 0).c_str(),
+        jsonNumber(bandwidth / peakBandwidth * 100, bytesMoved > 0 && peakBandwidth > 0).c_str()
+    );
+    fprintf(
+        file, ",\"peak_bytes\":%llu,\"peak_bytes_per_element\":%.6lf,\"allocations\":%llu,"
+        "\"allocation_time_ms\":%.6lf", (unsigned long long)allocationStatistics->peakBytes,
+        (double)allocationStatistics->peakBytes / arrayLength, (unsigned long long)allocationStatistics->numAllocations,
+        allocationStatistics->allocationTime
+    );
+
+    fprintf(
+        file, ",\"cpu_model\":\"%s\",\"num_cpus\":%u,\"cache_l1d_bytes\":%llu,\"cache_l2_bytes\":%llu,"
+        "\"cache_l3_bytes\":%llu,\"compiler\":\"%s\",\"compiler_flags\":\"%s\",\"git_commit\":\"%s\","
+        "\"threads\":%u,\"seed\":%llu}\n", jsonEscape(systemInfo->cpuModel).c_str(), systemInfo->numCpus,
+        (unsigned long long)systemInfo->cacheL1Data, (unsigned long long)systemInfo->cacheL2,
+        (unsigned long long)systemInfo->cacheL3, jsonEscape(systemInfo->compiler).c_str(),
+        jsonEscape(systemInfo->compilerFlags).c_str(), jsonEscape(systemInfo->gitCommit).c_str(), getNumThreads(),
+        (unsigned long long)seed
+    );
+
+    fclose(file);
+}
+
+/*
+Times sort with stopwatch, checks if sort is stable and checks if sort is ordering data correctly. Input data is
+copied from dataset, so all sorts sort identical arrays. Results are saved to files after the last repetition.
+In cold and page-cold test caches are evicted just before sort. In page-cold test input is copied to freshly mapped
+arrays and sort allocates its memory again in freshly mapped pages, which are touched for the first time by sort.
+*/
+SortRepetition testSort(
+    SortSequential *sort, dataset_t *dataset, data_t *keys, data_t *values, uint_t arrayLength, order_t sortOrder,
+    uint_t iteration, bool sortingKeyOnly, cache_mode_t cacheMode
+)
+{
+    if (cacheMode == CACHE_PAGE_COLD)
+    {
+        keys = (data_t*)allocateFreshPages(arrayLength * sizeof(*keys));
+        checkMallocError(keys);
+        values = (data_t*)allocateFreshPages(arrayLength * sizeof(*values));
+        checkMallocError(values);
+        sort->memoryDestroy();
+    }
+
+    memcpy(keys, dataset->keys, arrayLength * sizeof(*keys));
+    fingerprint_t inputFingerprint;
 
     if (sortingKeyOnly)
     {
-        sort->sort(keys, arrayLength, sortOrder);
+        inputFingerprint = computeFingerprint(keys, NULL, arrayLength);
     }
     else
     {
         fillArrayValueOnly(values, arrayLength);
-        sort->sort(keys, values, arrayLength, sortOrder);
+        inputFingerprint = computeFingerprint(keys, values, arrayLength);
     }
 
-    double time = sort->getSortTime();
-    writeTimeToFile(sort, distribution, time, sortingKeyOnly, iteration == testRepetitions - 1);
+    if (cacheMode != CACHE_WARM)
+    {
+        evictCaches();
+    }
 
-    // Sort correctness test
-    if (!(distribution == DISTRIBUTION_SORTED_ASC && sortOrder == ORDER_ASC ||
-          distribution == DISTRIBUTION_SORTED_DESC && sortOrder == ORDER_DESC)
-    )
+    setFreshPageAllocation(cacheMode == CACHE_PAGE_COLD);
+    if (sortingKeyOnly)
+    {
+        sort->sort(keys, arrayLength, sortOrder);
+    }
+    else
     {
-        sortCorrect(keysCopy, arrayLength, sortOrder);
+        sort->sort(keys, values, arrayLength, sortOrder);
     }
+    setFreshPageAllocation(false);
 
-    bool isCorrect = compareArrays(keys, keysCopy, arrayLength);
-    writeBoleanToFile(
-        FOLDER_SORT_CORRECTNESS, isCorrect, sort, distribution, arrayLength, sortOrder, sortingKeyOnly
-    );
+    SortRepetition repetition;
+    repetition.time = sort->getSortTime();
+    repetition.seed = dataset->seed;
+    repetition.bytesMoved = sort->getBytesMoved();
+    if (sort->isPerfCountersEnabled())
+    {
+        repetition.counters = sort->getPerfCounters();
+    }
 
+    // Sort correctness and stability are checked in the same linear pass (without reference sort)
+    bool isCorrect, isSortStable;
+    verifySort(
+        keys, sortingKeyOnly ? NULL : values, arrayLength, sortOrder, inputFingerprint, &isCorrect, &isSortStable
+    );
+    repetition.isCorrect = isCorrect;
     // Key-value sort has to be tested for stability
-    int_t isStable = -1;
-    if (!sortingKeyOnly)
+    repetition.isStable = sortingKeyOnly ? -1 : isSortStable;
+
+    printSortStatistics(
+        iteration, repetition.time, arrayLength, repetition.isCorrect, repetition.isStable, dataset->seed,
+        sort->isPerfCountersEnabled() ? &repetition.counters : NULL
+    );
+
+    if (cacheMode == CACHE_PAGE_COLD)
     {
-        isStable = isSortStable(keys, values, arrayLength);
-        writeBoleanToFile(
-            FOLDER_SORT_STABILITY, isStable, sort, distribution, arrayLength, sortOrder, sortingKeyOnly
-        );
+        freeFreshPages(keys, arrayLength * sizeof(*keys));
+        freeFreshPages(values, arrayLength * sizeof(*values));
     }
 
-    printSortStatistics(iteration, time, arrayLength, isCorrect, isStable);
+    return repetition;
 }
 
 /*
-Tests the sort and generates results.
+Executes the sort without saving any results. Warms up caches, TLB, branch predictors and memory of the sort
+(page faults on first touch), so they don't skew the first measured repetition.
 */
-void generateSortTestResults(
-    SortSequential *sort, data_dist_t distribution, data_t *keys, data_t *keysCopy, data_t *values,
-    uint_t arrayLength, order_t sortOrder, uint_t interval, uint_t testRepetitions, bool sortingKeyOnly
+void warmUpSort(
+    SortSequential *sort, dataset_t *dataset, data_t *keys, data_t *values, uint_t arrayLength,
+    order_t sortOrder, bool sortingKeyOnly
+)
+{
+    memcpy(keys, dataset->keys, arrayLength * sizeof(*keys));
+
+    if (sortingKeyOnly)
+    {
+        sort->sort(keys, arrayLength, sortOrder);
+    }
+    else
+    {
+        fillArrayValueOnly(values, arrayLength);
+        sort->sort(keys, values, arrayLength, sortOrder);
+    }
+}
+
+/*
+Checks if confidence interval of median time is narrow enough, so no additional repetitions are needed.
+*/
+bool isConfidenceIntervalNarrow(sample_statistics_t *statistics)
+{
+    double width = statistics->confidenceUpper - statistics->confidenceLower;
+    return width <= BENCHMARK_CI_RELATIVE_WIDTH * statistics->median;
+}
+
+/*
+Measures the sort on provided datasets and prints the results. Every repetition sorts its own dataset. Measured
+repetitions are preceded by warm-up repetitions. In adaptive mode additional repetitions (which reuse datasets) are
+executed, until confidence interval of median time is narrow enough. Memory of sort is released before the test,
+so allocation statistics contain only allocations of this test. Returns results of all repetitions.
+*/
+std::vector<SortRepetition> measureSort(
+    SortSequential *sort, data_dist_t distribution, dataset_t *datasets, data_t *keys, data_t *values,
+    uint_t arrayLength, order_t sortOrder, uint_t testRepetitions, bool sortingKeyOnly, cache_mode_t cacheMode,
+    sample_statistics_t *statistics, allocation_stats_t *allocationStatistics
 )
 {
     printf("> Distribution: %s\n", getDistributionName(distribution));
     printf("> Data type: %s\n", typeid(data_t).name());
     printf("> Array length: %d\n", arrayLength);
+    printf("> Threads: %u\n", getNumThreads());
+    printf("> Cache: %s\n", getCacheModeName(cacheMode));
     printf("> %s\n", sort->getSortName(sortingKeyOnly).c_str());
-    printTableHeader();
+    printTableHeader(sort->isPerfCountersEnabled());
+
+    sort->memoryDestroy();
+    resetAllocationStatistics();
 
-    // Tests sort for key only
-    for (uint_t iter = 0; iter < testRepetitions; iter++)
+    for (uint_t iter = 0; iter < BENCHMARK_WARMUP_REPETITIONS; iter++)
     {
-        testSort(
-            sort, distribution, keys, keysCopy, values, arrayLength, sortOrder, interval, iter, testRepetitions,
-            sortingKeyOnly
-        );
+        warmUpSort(sort, &datasets[0], keys, values, arrayLength, sortOrder, sortingKeyOnly);
+    }
+
+    // Phases recorded outside of measured repetitions (warm-up) aren't included in trace
+    if (TRACE_ENABLED)
+    {
+        clearTrace();
+    }
+
+    std::vector<SortRepetition> repetitions;
+    std::vector<double> times;
+    uint64_t bootstrapSeed = datasets[0].seed;
+
+    for (uint_t iter = 0; ; iter++)
+    {
+        if (iter >= testRepetitions)
+        {
+            *statistics = computeSampleStatistics(
+                times, BENCHMARK_BOOTSTRAP_SAMPLES, BENCHMARK_CONFIDENCE_LEVEL, bootstrapSeed
+            );
+
+            if (!BENCHMARK_ADAPTIVE_REPETITIONS || iter >= BENCHMARK_MAX_REPETITIONS ||
+                isConfidenceIntervalNarrow(statistics))
+            {
+                break;
+            }
+        }
+
+        repetitions.push_back(testSort(
+            sort, &datasets[iter % testRepetitions], keys, values, arrayLength, sortOrder, iter, sortingKeyOnly,
+            cacheMode
+        ));
+        times.push_back(repetitions.back().time);
     }
 
-    printTableLine();
+    // Timelines of all repetitions are saved to the same trace
+    if (TRACE_ENABLED)
+    {
+        std::string fileName = fileNameSort(sort, sortingKeyOnly, cacheMode) + ".json";
+        writeTraceToFile(folderPathDistribution(FOLDER_SORT_TRACES, distribution) + fileName);
+    }
+
+    *allocationStatistics = getAllocationStatistics();
+
+    printTableLine(sort->isPerfCountersEnabled());
+    printSummary(statistics);
+    printBandwidth(repetitions.back().bytesMoved, statistics);
+    printAllocationStatistics(allocationStatistics, arrayLength);
+
+    return repetitions;
 }
 
 /*
-Tests all provided sorts for all provided distributions.
+Tests the sort and saves results to files.
+*/
+void generateSortTestResults(
+    SortSequential *sort, data_dist_t distribution, dataset_t *datasets, data_t *keys, data_t *values,
+    uint_t arrayLength, order_t sortOrder, uint_t testRepetitions, bool sortingKeyOnly, cache_mode_t cacheMode,
+    system_info_t *systemInfo
+)
+{
+    sample_statistics_t statistics;
+    allocation_stats_t allocationStatistics;
+    std::vector<SortRepetition> repetitions = measureSort(
+        sort, distribution, datasets, keys, values, arrayLength, sortOrder, testRepetitions, sortingKeyOnly,
+        cacheMode, &statistics, &allocationStatistics
+    );
+
+    // Results of all repetitions are written at once, so files aren't opened during measurements
+    std::vector<bool> isCorrect, isStable;
+    for (uint_t i = 0; i < repetitions.size(); i++)
+    {
+        isCorrect.push_back(repetitions[i].isCorrect);
+        isStable.push_back(repetitions[i].isStable == 1);
+    }
+
+    writeTimesToFile(sort, distribution, repetitions, sortingKeyOnly, cacheMode);
+    if (sort->isPerfCountersEnabled())
+    {
+        writePerfCountersToFile(sort, distribution, repetitions, arrayLength, sortingKeyOnly, cacheMode);
+    }
+    writePredicatesToFile(
+        FOLDER_SORT_CORRECTNESS, isCorrect, sort, distribution, arrayLength, sortOrder, sortingKeyOnly, cacheMode
+    );
+    if (!sortingKeyOnly)
+    {
+        writePredicatesToFile(
+            FOLDER_SORT_STABILITY, isStable, sort, distribution, arrayLength, sortOrder, sortingKeyOnly, cacheMode
+        );
+    }
+    writeSummaryToFile(sort, distribution, &statistics, arrayLength, sortingKeyOnly, cacheMode);
+    writeResultToStream(
+        sort, distribution, repetitions, &statistics, &allocationStatistics, arrayLength, sortOrder, sortingKeyOnly,
+        cacheMode, systemInfo, datasets[0].seed
+    );
+}
+
+/*
+Tests all provided sorts for all provided distributions, array lengths and cache modes in one process. Key and
+value buffers are allocated once for the longest array and reused. Sorts allocate their memory again for every
+test (see "measureSort"). Datasets are saved to files only if "persistDatasets" is true.
 */
 void generateStatistics(
-    std::vector<SortSequential*> sorts, std::vector<data_dist_t> distributions, uint_t arrayLength,
-    order_t sortOrder, uint_t testRepetitions, uint_t interval
+    std::vector<SortSequential*> sorts, std::vector<data_dist_t> distributions, std::vector<uint_t> arrayLengths,
+    std::vector<cache_mode_t> cacheModes, order_t sortOrder, uint_t testRepetitions, uint_t interval, uint64_t seed,
+    bool persistDatasets, bool testKeyOnly, bool testKeyValue
 )
 {
     createFolderStructure(distributions);
-    std::string arrayLenStr = std::to_string(arrayLength) + std::string(FILE_NEW_LINE_CHAR);
-    appendToFile(FILE_ARRAY_LENGTHS, arrayLenStr);
+    system_info_t systemInfo = getSystemInfo();
+
+    uint_t maxArrayLength = 0;
+    for (uint_t i = 0; i < arrayLengths.size(); i++)
+    {
+        maxArrayLength = (std::max)(maxArrayLength, arrayLengths[i]);
+    }
 
-    data_t *keys = (data_t*)malloc(arrayLength * sizeof(*keys));
+    data_t *keys = (data_t*)malloc(maxArrayLength * sizeof(*keys));
     checkMallocError(keys);
-    data_t *keysCopy = (data_t*)malloc(arrayLength * sizeof(*keysCopy));
-    checkMallocError(keysCopy);
-    data_t *values = (data_t*)malloc(arrayLength * sizeof(*values));
+    data_t *values = (data_t*)malloc(maxArrayLength * sizeof(*values));
     checkMallocError(values);
 
-    for (std::vector<SortSequential*>::iterator sort = sorts.begin(); sort != sorts.end(); sort++)
+    for (uint_t len = 0; len < arrayLengths.size(); len++)
     {
-        for (std::vector<data_dist_t>::iterator dist = distributions.begin(); dist != distributions.end(); dist++)
+        uint_t arrayLength = arrayLengths[len];
+        std::string arrayLenStr = std::to_string(arrayLength) + std::string(FILE_NEW_LINE_CHAR);
+        appendToFile(FILE_ARRAY_LENGTHS, arrayLenStr);
+
+        for (uint_t dist = 0; dist < distributions.size(); dist++)
         {
-            // Sort key-only
-            generateSortTestResults(
-                *sort, *dist, keys, keysCopy, values, arrayLength, sortOrder, interval, testRepetitions, true
-            );
+            // Input data is generated only once for every repetition of distribution, and is shared by all sorts.
+            // Every repetition uses different seed. Seed depends only on repetition, so all sorts sort the same
+            // arrays. Only datasets of current distribution are open at the same time.
+            std::vector<dataset_t> datasets(testRepetitions);
+            for (uint_t iter = 0; iter < testRepetitions; iter++)
+            {
+                openDataset(
+                    &datasets[iter], FOLDER_SORT_DATASETS, distributions[dist], arrayLength, interval, seed + iter,
+                    persistDatasets
+                );
+            }
 
-            printf("\n\n");
+            for (std::vector<SortSequential*>::iterator sort = sorts.begin(); sort != sorts.end(); sort++)
+            {
+                for (uint_t cache = 0; cache < cacheModes.size(); cache++)
+                {
+                    // Sort key-only
+                    if (testKeyOnly)
+                    {
+                        generateSortTestResults(
+                            *sort, distributions[dist], datasets.data(), keys, values, arrayLength, sortOrder,
+                            testRepetitions, true, cacheModes[cache], &systemInfo
+                        );
 
-            // Sort key-value pairs
-            generateSortTestResults(
-                *sort, *dist, keys, keysCopy, values, arrayLength, sortOrder, interval, testRepetitions, false
-            );
+                        printf("\n\n");
+                    }
+
+                    // Sort key-value pairs
+                    if (testKeyValue)
+                    {
+                        generateSortTestResults(
+                            *sort, distributions[dist], datasets.data(), keys, values, arrayLength, sortOrder,
+                            testRepetitions, false, cacheModes[cache], &systemInfo
+                        );
+
+                        printf("\n\n");
+                    }
+                }
 
-            printf("\n\n");
+                (*sort)->memoryDestroy();
+            }
+
+            for (uint_t iter = 0; iter < testRepetitions; iter++)
+            {
+                closeDataset(&datasets[iter]);
+            }
         }
+    }
+
+    free(keys);
+    free(values);
+}
 
-        (*sort)->memoryDestroy();
+/*
+Returns the name of scaling mode.
+*/
+const char* getScalingModeName(scaling_mode_t scalingMode)
+{
+    return scalingMode == SCALING_STRONG ? "strong" : "weak";
+}
+
+/*
+Prints and saves scalability of sort. Speedup and parallel efficiency are relative to the first (smallest) number
+of threads. Serial fraction is estimated with Karp-Flatt metric for strong scaling and with Gustafson's law for
+weak scaling. Every line of file contains: number of threads, array length, median time, speedup, efficiency and
+serial fraction (-1 for the first number of threads).
+*/
+void writeScalingResults(
+    SortSequential *sort, data_dist_t distribution, scaling_mode_t scalingMode, std::vector<uint_t> &threadCounts,
+    std::vector<uint_t> &arrayLengths, std::vector<double> &medians, bool sortingKeyOnly
+)
+{
+    std::string fileName = strSlugify(sort->getSortName(sortingKeyOnly)) + "_" + getScalingModeName(scalingMode);
+    std::fstream file;
+    file.open(folderPathDistribution(FOLDER_SORT_SCALING, distribution) + fileName + FILE_EXTENSION, std::fstream::app);
+
+    printf(
+        "> Scaling (%s): %s, %s\n", getScalingModeName(scalingMode), sort->getSortName(sortingKeyOnly).c_str(),
+        getDistributionName(distribution)
+    );
+    printf("========================================================================================\n");
+    printf("|| THREADS ||       LENGTH ||      TIME     || SPEEDUP | EFFICIENCY | SERIAL FRACTION ||\n");
+    printf("========================================================================================\n");
+
+    for (uint_t i = 0; i < threadCounts.size(); i++)
+    {
+        double threadsRelative = (double)threadCounts[i] / threadCounts[0];
+        double speedup, efficiency, serialFraction = -1;
+
+        if (scalingMode == SCALING_STRONG)
+        {
+            speedup = medians[0] / medians[i];
+            efficiency = speedup / threadsRelative;
+            if (threadsRelative > 1)
+            {
+                serialFraction = (1 / speedup - 1 / threadsRelative) / (1 - 1 / threadsRelative);
+            }
+        }
+        else
+        {
+            efficiency = medians[0] / medians[i];
+            speedup = efficiency * threadsRelative;
+            if (threadsRelative > 1)
+            {
+                serialFraction = (threadsRelative - speedup) / (threadsRelative - 1);
+            }
+        }
+
+        printf(
+            "|| %7u || %12u || %10.2lf ms || %7.2lf | %9.1lf%% |", threadCounts[i], arrayLengths[i], medians[i],
+            speedup, efficiency * 100
+        );
+        if (threadsRelative <= 1)
+        {
+            printf(" %15s ||\n", "/");
+        }
+        else
+        {
+            printf(" %15.4lf ||\n", serialFraction);
+        }
+
+        file << threadCounts[i] << FILE_SEPARATOR_CHAR << arrayLengths[i] << FILE_SEPARATOR_CHAR << medians[i];
+        file << FILE_SEPARATOR_CHAR << speedup << FILE_SEPARATOR_CHAR << efficiency << FILE_SEPARATOR_CHAR;
+        file << serialFraction << FILE_NEW_LINE_CHAR;
+    }
+
+    printf("========================================================================================\n\n\n");
+    file.close();
+}
+
+/*
+Tests scalability of sorts: every sort is tested with all provided numbers of threads. In strong scaling array
+length is fixed, in weak scaling array length per thread is fixed (array length is multiplied by number of
+threads). Results of every number of threads are also saved to result stream. Scaling is tested with warm caches.
+*/
+void generateScalingStatistics(
+    std::vector<SortSequential*> sorts, std::vector<data_dist_t> distributions, std::vector<uint_t> arrayLengths,
+    std::vector<uint_t> threadCounts, std::vector<scaling_mode_t> scalingModes, order_t sortOrder,
+    uint_t testRepetitions, uint_t interval, uint64_t seed, bool persistDatasets, bool testKeyOnly,
+    bool testKeyValue
+)
+{
+    createFolderStructure(distributions);
+    system_info_t systemInfo = getSystemInfo();
+    uint_t numThreadsOriginal = getNumThreads();
+
+    uint64_t maxArrayLength = 0;
+    for (uint_t i = 0; i < arrayLengths.size(); i++)
+    {
+        maxArrayLength = (std::max)(maxArrayLength, (uint64_t)arrayLengths[i]);
+    }
+    for (uint_t i = 0; i < scalingModes.size(); i++)
+    {
+        if (scalingModes[i] == SCALING_WEAK)
+        {
+            maxArrayLength *= threadCounts.back();
+        }
+    }
+    if (maxArrayLength > UINT32_MAX)
+    {
+        printf("Array length of weak scaling is too large.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    data_t *keys = (data_t*)malloc(maxArrayLength * sizeof(*keys));
+    checkMallocError(keys);
+    data_t *values = (data_t*)malloc(maxArrayLength * sizeof(*values));
+    checkMallocError(values);
+
+    for (uint_t len = 0; len < arrayLengths.size(); len++)
+    {
+        for (uint_t scaling = 0; scaling < scalingModes.size(); scaling++)
+        {
+            for (std::vector<SortSequential*>::iterator sort = sorts.begin(); sort != sorts.end(); sort++)
+            {
+                for (uint_t dist = 0; dist < distributions.size(); dist++)
+                {
+                    for (uint_t mode = 0; mode < 2; mode++)
+                    {
+                        bool sortingKeyOnly = mode == 0;
+                        if (sortingKeyOnly ? !testKeyOnly : !testKeyValue)
+                        {
+                            continue;
+                        }
+
+                        std::vector<uint_t> lengths;
+                        std::vector<double> medians;
+
+                        for (uint_t t = 0; t < threadCounts.size(); t++)
+                        {
+                            uint_t arrayLength = arrayLengths[len];
+                            if (scalingModes[scaling] == SCALING_WEAK)
+                            {
+                                arrayLength *= threadCounts[t];
+                            }
+                            setNumThreads(threadCounts[t]);
+
+                            std::vector<dataset_t> datasets(testRepetitions);
+                            for (uint_t iter = 0; iter < testRepetitions; iter++)
+                            {
+                                openDataset(
+                                    &datasets[iter], FOLDER_SORT_DATASETS, distributions[dist], arrayLength,
+                                    interval, seed + iter, persistDatasets
+                                );
+                            }
+
+                            sample_statistics_t statistics;
+                            allocation_stats_t allocationStatistics;
+                            std::vector<SortRepetition> repetitions = measureSort(
+                                *sort, distributions[dist], datasets.data(), keys, values, arrayLength,
+                                sortOrder, testRepetitions, sortingKeyOnly, CACHE_WARM, &statistics,
+                                &allocationStatistics
+                            );
+                            writeResultToStream(
+                                *sort, distributions[dist], repetitions, &statistics, &allocationStatistics,
+                                arrayLength, sortOrder, sortingKeyOnly, CACHE_WARM, &systemInfo, datasets[0].seed
+                            );
+                            printf("\n\n");
+
+                            lengths.push_back(arrayLength);
+                            medians.push_back(statistics.median);
+
+                            for (uint_t iter = 0; iter < testRepetitions; iter++)
+                            {
+                                closeDataset(&datasets[iter]);
+                            }
+                        }
+
+                        writeScalingResults(
+                            *sort, distributions[dist], scalingModes[scaling], threadCounts, lengths, medians,
+                            sortingKeyOnly
+                        );
+                    }
+                }
+
+                (*sort)->memoryDestroy();
+            }
+        }
     }
 
+    setNumThreads(numThreadsOriginal);
     free(keys);
-    free(keysCopy);
     free(values);
 }
@@ -1,6 +1,7 @@
 #ifndef TEST_SORT_H
 #define TEST_SORT_H
 
+#include <stdint.h>
 #include <vector>
 #include <memory>
 
@@ -8,9 +9,44 @@
 #include "../Utils/sort_interface.h"
 
 
+/*
+Scaling test of multithreaded sorts: in strong scaling array length is fixed, in weak scaling array length per
+thread is fixed.
+*/
+enum ScalingMode
+{
+    SCALING_STRONG,
+    SCALING_WEAK
+};
+
+typedef enum ScalingMode scaling_mode_t;
+
+/*
+State of caches and memory before every repetition: in warm test input was just written (it is in cache) and sort
+reuses its memory from previous repetitions, in cold test caches are evicted before sort, in page-cold test caches
+are evicted and input and sort memory are in freshly mapped pages.
+*/
+enum CacheMode
+{
+    CACHE_WARM,
+    CACHE_COLD,
+    CACHE_PAGE_COLD
+};
+
+typedef enum CacheMode cache_mode_t;
+
+const char* getCacheModeName(cache_mode_t cacheMode);
+
 void generateStatistics(
-    std::vector<SortSequential*> sorts, std::vector<data_dist_t> distributions, uint_t arrayLength,
-    order_t sortOrder, uint_t testRepetitions, uint_t interval
+    std::vector<SortSequential*> sorts, std::vector<data_dist_t> distributions, std::vector<uint_t> arrayLengths,
+    std::vector<cache_mode_t> cacheModes, order_t sortOrder, uint_t testRepetitions, uint_t interval, uint64_t seed,
+    bool persistDatasets, bool testKeyOnly, bool testKeyValue
+);
+void generateScalingStatistics(
+    std::vector<SortSequential*> sorts, std::vector<data_dist_t> distributions, std::vector<uint_t> arrayLengths,
+    std::vector<uint_t> threadCounts, std::vector<scaling_mode_t> scalingModes, order_t sortOrder,
+    uint_t testRepetitions, uint_t interval, uint64_t seed, bool persistDatasets, bool testKeyOnly,
+    bool testKeyValue
 );
 
 #endif
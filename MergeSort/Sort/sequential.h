@@ -8,6 +8,8 @@
 #include "../../Utils/data_types_common.h"
 #include "../../Utils/sort_interface.h"
 #include "../../Utils/host.h"
+#include "../../Utils/allocation.h"
+#include "../../Utils/trace.h"
 
 
 /*
@@ -30,9 +32,9 @@ protected:
     {
         SortSequential::memoryAllocate(h_keys, h_values, arrayLength);
 
-        _h_keysBuffer = (data_t*)malloc(arrayLength * sizeof(*_h_keysBuffer));
+        _h_keysBuffer = (data_t*)trackedMalloc(arrayLength * sizeof(*_h_keysBuffer));
         checkMallocError(_h_keysBuffer);
-        _h_valuesBuffer = (data_t*)malloc(arrayLength * sizeof(*_h_valuesBuffer));
+        _h_valuesBuffer = (data_t*)trackedMalloc(arrayLength * sizeof(*_h_valuesBuffer));
         checkMallocError(_h_valuesBuffer);
     }
 
@@ -171,12 +173,14 @@ protected:
         data_t *h_valuesSorted, uint_t arrayLength
     )
     {
+        // Array with one element is already sorted. It is copied to output array of the last merge phase, which is
+        // the input array in merge sort and array for sorted data in sample sort.
         if (arrayLength == 1)
         {
-            h_keysSorted[0] = h_keys[0];
+            getOutputMergeArray(h_keys, h_keysSorted, true)[0] = h_keys[0];
             if (!sortingKeyOnly)
             {
-                h_valuesSorted[0] = h_values[0];
+                getOutputMergeArray(h_values, h_valuesSorted, true)[0] = h_values[0];
             }
             return;
         }
@@ -189,6 +193,7 @@ protected:
             // Number of merged blocks that will be created in this iteration
             uint_t numBlocks = (arrayLength - 1) / sortedBlockSize + 1;
             bool isLastMergePhase = numBlocks == 1;
+            TRACE_SCOPE_SIZED("merge pass", "sorted block size", sortedBlockSize, arrayLength);
 
             // Merge of all blocks
             for (uint_t blockIndex = 0; blockIndex < numBlocks; blockIndex++)
@@ -261,8 +266,8 @@ protected:
 
         SortSequential::memoryDestroy();
 
-        free(_h_keysBuffer);
-        free(_h_valuesBuffer);
+        trackedFree(_h_keysBuffer);
+        trackedFree(_h_valuesBuffer);
     }
 
 public:
@@ -270,6 +275,19 @@ public:
     {
         return this->_sortName;
     }
+
+    /*
+    Every merge phase reads and writes keys and values once. Phases merge from array to buffer and back, so they are
+    executed from main memory, unless array and buffer fit into last level cache.
+    */
+    double getBytesMoved()
+    {
+        double numPhases = _arrayLength > 1 ? log2((double)nextPowerOf2(_arrayLength)) : 0;
+        double numMemoryPhases = getNumMemoryLevels(numPhases, 1, 2 * getElementSize());
+
+        return getBytesOfPasses(2 * numMemoryPhases, 2 * numMemoryPhases) +
+            getBytesOfCacheLevels(numPhases, numMemoryPhases);
+    }
 };
 
 #endif
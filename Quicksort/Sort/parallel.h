@@ -2,7 +2,7 @@
 #define QUICKSORT_PARALLEL_H
 
 #include "../../Utils/data_types_common.h"
-#include "../../Utils/sort_interface.h"
+#include "../../Utils/sort_interface_parallel.h"
 #include "../constants.h"
 #include "../data_types.h"
 
@@ -8,6 +8,7 @@
 #include "../../Utils/data_types_common.h"
 #include "../../Utils/sort_interface.h"
 #include "../../Utils/host.h"
+#include "../../Utils/trace.h"
 
 
 /*
@@ -141,7 +142,12 @@ protected:
             return;
         }
 
-        uint_t partition = partitionArray<sortOrder>(h_keys, arrayLength);
+        uint_t partition;
+        {
+            TRACE_SCOPE_SIZED("quicksort partition", "length", arrayLength, arrayLength);
+            partition = partitionArray<sortOrder>(h_keys, arrayLength);
+        }
+
         quicksortSequential<sortOrder>(h_keys, partition);
         quicksortSequential<sortOrder>(h_keys + partition + 1, arrayLength - partition - 1);
     }
@@ -166,7 +172,12 @@ protected:
             return;
         }
 
-        uint_t partition = partitionArray<sortOrder>(h_keys, h_values, arrayLength);
+        uint_t partition;
+        {
+            TRACE_SCOPE_SIZED("quicksort partition", "length", arrayLength, arrayLength);
+            partition = partitionArray<sortOrder>(h_keys, h_values, arrayLength);
+        }
+
         quicksortSequential<sortOrder>(h_keys, h_values, partition);
         quicksortSequential<sortOrder>(h_keys + partition + 1, h_values + partition + 1, arrayLength - partition - 1);
     }
@@ -208,6 +219,19 @@ public:
     {
         return this->_sortName;
     }
+
+    /*
+    Every partition reads and writes its subarray once. If pivots split subarrays in half, there are "log2(n)"
+    levels of partitions. Levels with subarrays, which fit into last level cache, don't access main memory.
+    */
+    double getBytesMoved()
+    {
+        double numLevels = _arrayLength > 1 ? log2((double)_arrayLength) : 0;
+        double numMemoryLevels = getNumMemoryLevels(numLevels, 2, getElementSize());
+
+        return getBytesOfPasses(2 * numMemoryLevels, 2 * numMemoryLevels) +
+            getBytesOfCacheLevels(numLevels, numMemoryLevels);
+    }
 };
 
 #endif
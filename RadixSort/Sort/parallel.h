@@ -10,7 +10,7 @@
 #include <cudpp.h>
 
 #include "../../Utils/data_types_common.h"
-#include "../../Utils/sort_interface.h"
+#include "../../Utils/sort_interface_parallel.h"
 #include "../../Utils/kernels_classes.h"
 #include "../../Utils/host.h"
 #include "../constants.h"
@@ -461,7 +461,7 @@ class RadixSortParallelBase : public RadixSortParallelParent<
 Class for parallel radix sort.
 */
 class RadixSortParallel : public RadixSortParallelBase<
-    THREADS_PADDING, ELEMS_PADDING,
+    RADIX_THREADS_PADDING, RADIX_ELEMS_PADDING,
     THREADS_LOCAL_SORT_KO, ELEMS_LOCAL_KO,
     THREADS_LOCAL_SORT_KV, ELEMS_LOCAL_KV,
     THREADS_GEN_BUCKETS_KO, THREADS_GEN_BUCKETS_KV,
@@ -8,13 +8,48 @@
 #include "../../Utils/data_types_common.h"
 #include "../../Utils/sort_interface.h"
 #include "../../Utils/host.h"
+#include "../../Utils/allocation.h"
+#include "../../Utils/trace.h"
 #include "../constants.h"
 
 
+/*
+Returns the digit of key on provided bit offset. For descending order digits are inverted, so elements can always
+be scattered in ascending order of digits.
+*/
+template <order_t sortOrder, uint_t radix>
+inline uint_t getDigitSequential(data_t key, uint_t bitOffset)
+{
+    uint_t digit = (key >> bitOffset) & (radix - 1);
+    return sortOrder == ORDER_ASC ? digit : radix - 1 - digit;
+}
+
+/*
+Stores elements to their output positions according to digit on provided bit offset. Before the call counters
+have to hold EXCLUSIVE offsets of digits. Elements are scattered in input order, so the scatter is stable.
+*/
+template <order_t sortOrder, bool sortingKeyOnly, uint_t radix>
+void scatterElementsSequential(
+    data_t *h_keys, data_t *h_values, data_t *h_keysOutput, data_t *h_valuesOutput, uint_t *dataCounters,
+    uint_t tableLen, uint_t bitOffset
+)
+{
+    for (uint_t i = 0; i < tableLen; i++)
+    {
+        uint_t outputIndex = dataCounters[getDigitSequential<sortOrder, radix>(h_keys[i], bitOffset)]++;
+
+        h_keysOutput[outputIndex] = h_keys[i];
+        if (!sortingKeyOnly)
+        {
+            h_valuesOutput[outputIndex] = h_values[i];
+        }
+    }
+}
+
+
 /*
 Parent class for sequential radix sort. Not to be used directly - it's inherited by bottom class, which performs
 partial template specialization.
-TODO implement for descending order.
 */
 template <uint_t bitCountRadixKo, uint_t radixKo, uint_t bitCountRadixKv, uint_t radixKv>
 class RadixSortSequentialParent : public SortSequential
@@ -38,11 +73,11 @@ protected:
         uint_t maxRadix = max(radixKo, radixKv);
 
         // Allocates keys and values
-        _h_keysBuffer = (data_t*)malloc(arrayLength * sizeof(*_h_keysBuffer));
+        _h_keysBuffer = (data_t*)trackedMalloc(arrayLength * sizeof(*_h_keysBuffer));
         checkMallocError(_h_keysBuffer);
-        _h_valuesBuffer = (data_t*)malloc(arrayLength * sizeof(*_h_valuesBuffer));
+        _h_valuesBuffer = (data_t*)trackedMalloc(arrayLength * sizeof(*_h_valuesBuffer));
         checkMallocError(_h_valuesBuffer);
-        _h_dataCounters = (uint_t*)malloc(maxRadix * sizeof(*_h_dataCounters));
+        _h_dataCounters = (uint_t*)trackedMalloc(maxRadix * sizeof(*_h_dataCounters));
         checkMallocError(_h_dataCounters);
     }
 
@@ -80,35 +115,36 @@ protected:
         uint_t tableLen, uint_t bitOffset
     )
     {
-        // Resets counters
-        for (uint_t i = 0; i < radix; i++)
         {
-            dataCounters[i] = 0;
-        }
-
-        // Counts number of element occurrences
-        for (uint_t i = 0; i < tableLen; i++)
-        {
-            dataCounters[(h_keys[i] >> bitOffset) & (radix - 1)]++;
-        }
+            TRACE_SCOPE("radix histogram");
 
-        // Performs scan on counters
-        for (uint_t i = 1; i < radix; i++)
-        {
-            dataCounters[i] += dataCounters[i - 1];
-        }
+            // Resets counters
+            for (uint_t i = 0; i < radix; i++)
+            {
+                dataCounters[i] = 0;
+            }
 
-        // Scatters elements to their output position
-        for (int_t i = tableLen - 1; i >= 0; i--)
-        {
-            uint_t outputIndex = --dataCounters[(h_keys[i] >> bitOffset) & (radix - 1)];
+            // Counts number of element occurrences
+            for (uint_t i = 0; i < tableLen; i++)
+            {
+                dataCounters[getDigitSequential<sortOrder, radix>(h_keys[i], bitOffset)]++;
+            }
 
-            h_keysBuffer[outputIndex] = h_keys[i];
-            if (!sortingKeyOnly)
+            // Performs EXCLUSIVE scan on counters
+            uint_t sum = 0;
+            for (uint_t i = 0; i < radix; i++)
             {
-                h_valuesBuffer[outputIndex] = h_values[i];
+                uint_t count = dataCounters[i];
+                dataCounters[i] = sum;
+                sum += count;
             }
         }
+
+        // Scatters elements to their output position
+        TRACE_SCOPE("radix scatter");
+        scatterElementsSequential<sortOrder, sortingKeyOnly, radix>(
+            h_keys, h_values, h_keysBuffer, h_valuesBuffer, dataCounters, tableLen, bitOffset
+        );
     }
 
     /*
@@ -123,6 +159,7 @@ protected:
         // Executes counting sort for every digit (every group of BIT_COUNT_SEQUENTIAL bits)
         for (uint_t bitOffset = 0; bitOffset < sizeof(data_t)* 8; bitOffset += bitCountRadix)
         {
+            TRACE_SCOPE_ARG("radix pass", "bit offset", bitOffset);
             countingSort<sortOrder, sortingKeyOnly, radix>(
                 h_keys, h_values, h_keysBuffer, h_valuesBuffer, dataCounters, arrayLength, bitOffset
             );
@@ -186,6 +223,21 @@ public:
         return this->_sortName;
     }
 
+    /*
+    Every counting sort reads keys twice (histogram and scatter) and writes them once. Values are read and written
+    once. Every counting sort passes over whole array and buffer, so they are executed from main memory, unless
+    array and buffer fit into last level cache.
+    */
+    double getBytesMoved()
+    {
+        uint_t bitCountRadix = _h_values == NULL ? bitCountRadixKo : bitCountRadixKv;
+        double numPasses = (DATA_TYPE_BITS + bitCountRadix - 1) / bitCountRadix;
+        double numMemoryPasses = getNumMemoryLevels(numPasses, 1, 2 * getElementSize());
+
+        return getBytesOfPasses(3 * numMemoryPasses, 2 * numMemoryPasses) +
+            getBytesOfCacheLevels(numPasses, numMemoryPasses);
+    }
+
     /*
     Method for destroying memory needed for sort. For sort testing purposes this method is public.
     */
@@ -198,9 +250,9 @@ public:
 
         SortSequential::memoryDestroy();
 
-        free(_h_keysBuffer);
-        free(_h_valuesBuffer);
-        free(_h_dataCounters);
+        trackedFree(_h_keysBuffer);
+        trackedFree(_h_valuesBuffer);
+        trackedFree(_h_dataCounters);
     }
 };
 
@@ -1,7 +1,7 @@
 #ifndef CONSTANTS_RADIX_SORT_H
 #define CONSTANTS_RADIX_SORT_H
 
-#include "../../Utils/data_types_common.h"
+#include "../Utils/data_types_common.h"
 
 
 /*
@@ -12,9 +12,9 @@ _KV: Key-value
 /* ------------------ PADDING KERNEL ----------------- */
 
 // How many threads are used per on thread block for padding. Has to be power of 2.
-#define THREADS_PADDING 128
+#define RADIX_THREADS_PADDING 128
 // How many table elements are processed by one thread in padding kernel. Min value is 2.
-#define ELEMS_PADDING 4
+#define RADIX_ELEMS_PADDING 4
 
 
 /* ----------------- RADIX SORT LOCAL ---------------- */
@@ -0,0 +1,299 @@
+#ifndef SAMPLE_SORT_HYBRID_H
+#define SAMPLE_SORT_HYBRID_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+
+#include "../../Utils/data_types_common.h"
+#include "../../Utils/host.h"
+#include "../../Utils/trace.h"
+#include "../../RadixSort/Sort/sequential.h"
+#include "../constants.h"
+#include "sequential.h"
+
+
+/*
+Parent class for hybrid sample sort. Not to be used directly - it's inherited by bottom class, which performs
+partial template specialization.
+
+Array is distributed into buckets with sequential sample sort, until buckets fit into L2 cache. Every bucket is then
+sorted with LSD radix sort, which is faster than merge sort for integer keys. Both distribution and radix sort are
+stable, so the whole sort is stable.
+
+Template params:
+_Ko - Key-only
+_Kv - Key-value
+*/
+template <
+    uint_t numSplittersKo, uint_t numSplittersKv,
+    uint_t numSamplesKo, uint_t numSamplesKv,
+    uint_t oversamplingFactorKo, uint_t oversamplingFactorKv,
+    uint_t bucketThresholdKo, uint_t bucketThresholdKv,
+    uint_t bitCountRadixKo, uint_t bitCountRadixKv
+>
+class SampleSortHybridParent : public SampleSortSequentialParent<
+    numSplittersKo, numSplittersKv,
+    numSamplesKo, numSamplesKv,
+    oversamplingFactorKo, oversamplingFactorKv,
+    bucketThresholdKo, bucketThresholdKv
+>
+{
+protected:
+    std::string _sortName = "Sample sort hybrid sequential";
+
+    /*
+    Sorts bucket with LSD radix sort and outputs sorted data to result array. Counters for all digits are computed
+    in one pass over bucket. Digits, which are the same for all elements in bucket, are skipped. Because bucket
+    contains only elements between two neighbouring splitters, higher digits are often the same.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly, uint_t bitCountRadix>
+    void radixSortBucket(
+        data_t *h_keys, data_t *h_values, data_t *h_keysBuffer, data_t *h_valuesBuffer, data_t *h_keysSorted,
+        data_t *h_valuesSorted, uint_t arrayLength
+    )
+    {
+        const uint_t radix = 1 << bitCountRadix;
+        const uint_t numDigits = (DATA_TYPE_BITS + bitCountRadix - 1) / bitCountRadix;
+        uint_t dataCounters[numDigits][radix];
+        uint_t digitsToSort[numDigits];
+        uint_t numPasses = 0;
+
+        for (uint_t digit = 0; digit < numDigits; digit++)
+        {
+            std::fill(dataCounters[digit], dataCounters[digit] + radix, 0);
+        }
+
+        // Counts number of element occurrences for all digits
+        for (uint_t i = 0; i < arrayLength; i++)
+        {
+            data_t key = h_keys[i];
+
+            for (uint_t digit = 0; digit < numDigits; digit++)
+            {
+                dataCounters[digit][getDigitSequential<sortOrder, radix>(key, digit * bitCountRadix)]++;
+            }
+        }
+
+        // Performs EXCLUSIVE scan on counters of digits, which are not the same for all elements
+        for (uint_t digit = 0; digit < numDigits; digit++)
+        {
+            uint_t *counters = dataCounters[digit];
+
+            if (counters[getDigitSequential<sortOrder, radix>(h_keys[0], digit * bitCountRadix)] == arrayLength)
+            {
+                continue;
+            }
+
+            this->exclusiveScan(counters, radix);
+            digitsToSort[numPasses++] = digit;
+        }
+
+        if (numPasses == 0)
+        {
+            this->template copyEqualityBucket<sortingKeyOnly>(
+                h_keys, h_values, h_keysSorted, h_valuesSorted, 0, arrayLength
+            );
+            return;
+        }
+
+        // Primary and buffer arrays are exchanged after every pass. The last pass outputs data to sorted array.
+        for (uint_t pass = 0; pass < numPasses; pass++)
+        {
+            bool isLastPass = pass == numPasses - 1;
+            data_t *h_keysOutput = isLastPass ? h_keysSorted : h_keysBuffer;
+            data_t *h_valuesOutput = isLastPass ? h_valuesSorted : h_valuesBuffer;
+
+            scatterElementsSequential<sortOrder, sortingKeyOnly, radix>(
+                h_keys, h_values, h_keysOutput, h_valuesOutput, dataCounters[digitsToSort[pass]], arrayLength,
+                digitsToSort[pass] * bitCountRadix
+            );
+
+            std::swap(h_keys, h_keysBuffer);
+            if (!sortingKeyOnly)
+            {
+                std::swap(h_values, h_valuesBuffer);
+            }
+        }
+    }
+
+    /*
+    Sorts array with hybrid sample sort and outputs sorted data to result array.
+    */
+    template <
+        order_t sortOrder, bool sortingKeyOnly, uint_t numSplitters, uint_t oversamplingFactor,
+        uint_t bucketThreshold, uint_t bitCountRadix
+    >
+    void sampleSortHybrid(
+        data_t *h_keys, data_t *h_values, data_t *h_keysBuffer, data_t *h_valuesBuffer, data_t *h_keysSorted,
+        data_t *h_valuesSorted, data_t *h_samples, uint8_t *h_elementBuckets, uint_t arrayLength
+    )
+    {
+        // When bucket fits into cache, it is sorted with radix sort
+        if (arrayLength <= bucketThreshold)
+        {
+            radixSortBucket<sortOrder, sortingKeyOnly, bitCountRadix>(
+                h_keys, h_values, h_keysBuffer, h_valuesBuffer, h_keysSorted, h_valuesSorted, arrayLength
+            );
+            return;
+        }
+
+        // Holds bucket offsets. A new array is needed for every level of recursion.
+        uint_t bucketOffsets[numSplitters + 1];
+        bool isEqualityBucket[numSplitters + 1];
+
+        uint_t numBuckets = this->template distributeElements<
+            sortOrder, sortingKeyOnly, numSplitters, oversamplingFactor
+        >(
+            h_keys, h_values, h_keysBuffer, h_valuesBuffer, h_samples, h_elementBuckets, bucketOffsets,
+            isEqualityBucket, arrayLength
+        );
+
+        // Recursively sorts buckets
+        TRACE_SCOPE_SIZED("sample sort recursion", "length", arrayLength, arrayLength);
+        for (uint_t i = 0; i < numBuckets; i++)
+        {
+            uint_t prevBucketOffset = i > 0 ? bucketOffsets[i - 1] : 0;
+            uint_t bucketSize = bucketOffsets[i] - prevBucketOffset;
+
+            if (isEqualityBucket[i])
+            {
+                this->template copyEqualityBucket<sortingKeyOnly>(
+                    h_keysBuffer, h_valuesBuffer, h_keysSorted, h_valuesSorted, prevBucketOffset, bucketSize
+                );
+                continue;
+            }
+
+            if (bucketSize > 0)
+            {
+                // Primary and buffer arrays are exchanged
+                sampleSortHybrid<
+                    sortOrder, sortingKeyOnly, numSplitters, oversamplingFactor, bucketThreshold, bitCountRadix
+                >(
+                    h_keysBuffer + prevBucketOffset, sortingKeyOnly ? NULL : h_valuesBuffer + prevBucketOffset,
+                    h_keys + prevBucketOffset, sortingKeyOnly ? NULL : h_values + prevBucketOffset,
+                    h_keysSorted + prevBucketOffset, sortingKeyOnly ? NULL : h_valuesSorted + prevBucketOffset,
+                    h_samples, h_elementBuckets, bucketSize
+                );
+            }
+        }
+    }
+
+    /*
+    Wrapper for hybrid sample sort method.
+    The code runs faster if arguments are passed to method. If members are accessed directly, code runs slower.
+    */
+    void sortKeyOnly()
+    {
+        if (this->_sortOrder == ORDER_ASC)
+        {
+            sampleSortHybrid<
+                ORDER_ASC, true, numSplittersKo, oversamplingFactorKo, bucketThresholdKo, bitCountRadixKo
+            >(
+                this->_h_keys, NULL, this->_h_keysBuffer, NULL, this->_h_keysSorted, NULL, this->_h_samples,
+                this->_h_elementBuckets, this->_arrayLength
+            );
+        }
+        else
+        {
+            sampleSortHybrid<
+                ORDER_DESC, true, numSplittersKo, oversamplingFactorKo, bucketThresholdKo, bitCountRadixKo
+            >(
+                this->_h_keys, NULL, this->_h_keysBuffer, NULL, this->_h_keysSorted, NULL, this->_h_samples,
+                this->_h_elementBuckets, this->_arrayLength
+            );
+        }
+    }
+
+    /*
+    Wrapper for hybrid sample sort method.
+    The code runs faster if arguments are passed to method. If members are accessed directly, code runs slower.
+    */
+    void sortKeyValue()
+    {
+        if (this->_sortOrder == ORDER_ASC)
+        {
+            sampleSortHybrid<
+                ORDER_ASC, false, numSplittersKv, oversamplingFactorKv, bucketThresholdKv, bitCountRadixKv
+            >(
+                this->_h_keys, this->_h_values, this->_h_keysBuffer, this->_h_valuesBuffer, this->_h_keysSorted,
+                this->_h_valuesSorted, this->_h_samples, this->_h_elementBuckets, this->_arrayLength
+            );
+        }
+        else
+        {
+            sampleSortHybrid<
+                ORDER_DESC, false, numSplittersKv, oversamplingFactorKv, bucketThresholdKv, bitCountRadixKv
+            >(
+                this->_h_keys, this->_h_values, this->_h_keysBuffer, this->_h_valuesBuffer, this->_h_keysSorted,
+                this->_h_valuesSorted, this->_h_samples, this->_h_elementBuckets, this->_arrayLength
+            );
+        }
+    }
+
+public:
+    std::string getSortName()
+    {
+        return this->_sortName;
+    }
+
+    /*
+    Distribution is the same as in sequential sample sort. Radix sort of bucket reads keys once to count all digits
+    and then reads and writes keys and values once for every digit. It is executed from main memory only if bucket
+    and its buffer don't fit into last level cache.
+    */
+    double getBytesMoved()
+    {
+        bool sortingKeyOnly = this->_h_values == NULL;
+        uint_t numBuckets = (sortingKeyOnly ? numSplittersKo : numSplittersKv) + 1;
+        uint_t bucketThreshold = sortingKeyOnly ? bucketThresholdKo : bucketThresholdKv;
+        uint_t bitCountRadix = sortingKeyOnly ? bitCountRadixKo : bitCountRadixKv;
+        double numDigits = (DATA_TYPE_BITS + bitCountRadix - 1) / bitCountRadix;
+        double bucketLength;
+
+        double numLevels = this->getNumDistributionLevels(
+            this->_arrayLength, numBuckets, bucketThreshold, &bucketLength
+        );
+        double numMemoryLevels = this->getNumMemoryLevels(
+            numLevels, numBuckets, 2 * this->getElementSize() + sizeof(*this->_h_elementBuckets)
+        );
+        bool isBucketInCache = bucketLength * 2 * this->getElementSize() <= getLastLevelCacheSize();
+        bool isRadixInMemory = numMemoryLevels == numLevels && !isBucketInCache;
+        double bytesBuckets = 2 * numMemoryLevels * this->_arrayLength * sizeof(*this->_h_elementBuckets);
+        double bytesRadix = isRadixInMemory ? this->getBytesOfPasses(1 + 2 * numDigits, 2 * numDigits) : 0;
+
+        return this->getBytesOfPasses(3 * numMemoryLevels, 2 * numMemoryLevels) + bytesBuckets + bytesRadix +
+            this->getBytesOfCacheLevels(numLevels + 1, numMemoryLevels + isRadixInMemory);
+    }
+};
+
+/*
+Base class for hybrid sample sort.
+*/
+template <
+    uint_t numSplittersKo, uint_t numSplittersKv,
+    uint_t oversamplingFactorKo, uint_t oversamplingFactorKv,
+    uint_t bucketThresholdKo, uint_t bucketThresholdKv,
+    uint_t bitCountRadixKo, uint_t bitCountRadixKv
+>
+class SampleSortHybridBase : public SampleSortHybridParent<
+    numSplittersKo, numSplittersKv,
+    numSplittersKo * oversamplingFactorKo, numSplittersKv * oversamplingFactorKv,
+    oversamplingFactorKo, oversamplingFactorKv,
+    bucketThresholdKo, bucketThresholdKv,
+    bitCountRadixKo, bitCountRadixKv
+>
+{};
+
+/*
+Class for hybrid sample sort.
+*/
+class SampleSortHybrid : public SampleSortHybridBase<
+    NUM_SPLITTERS_SEQUENTIAL_KO, NUM_SPLITTERS_SEQUENTIAL_KV,
+    OVERSAMPLING_FACTOR_KO, OVERSAMPLING_FACTOR_KV,
+    BUCKET_THRESHOLD_HYBRID_KO, BUCKET_THRESHOLD_HYBRID_KV,
+    BIT_COUNT_SEQUENTIAL_KO, BIT_COUNT_SEQUENTIAL_KV
+>
+{};
+
+#endif
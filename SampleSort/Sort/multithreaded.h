@@ -0,0 +1,485 @@
+#ifndef SAMPLE_SORT_MULTITHREADED_H
+#define SAMPLE_SORT_MULTITHREADED_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <random>
+#include <chrono>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+#include <functional>
+
+#include "../../Utils/data_types_common.h"
+#include "../../Utils/threads.h"
+#include "../../Utils/host.h"
+#include "../../Utils/allocation.h"
+#include "../../Utils/trace.h"
+#include "../constants.h"
+#include "sequential.h"
+
+
+/*
+Parent class for multithreaded sample sort. Not to be used directly - it's inherited by bottom class, which
+performs partial template specialization.
+
+Uses the same splitters, classification and relocation as sequential sample sort, but every step is executed by
+multiple threads. Every thread classifies and relocates it's own chunk of array, so the distribution stays stable.
+
+Template params:
+_Ko - Key-only
+_Kv - Key-value
+*/
+template <
+    uint_t numSplittersKo, uint_t numSplittersKv,
+    uint_t numSamplesKo, uint_t numSamplesKv,
+    uint_t oversamplingFactorKo, uint_t oversamplingFactorKv,
+    uint_t smallSortThresholdKo, uint_t smallSortThresholdKv
+>
+class SampleSortMultithreadedParent : public SampleSortSequentialParent<
+    numSplittersKo, numSplittersKv,
+    numSamplesKo, numSamplesKv,
+    oversamplingFactorKo, oversamplingFactorKv,
+    smallSortThresholdKo, smallSortThresholdKv
+>
+{
+protected:
+    std::string _sortName = "Sample sort multithreaded";
+
+    // Samples of every thread
+    data_t *_h_samplesThreads = NULL;
+    // Bucket sizes of every thread and bucket offsets of every thread after exclusive scan
+    uint_t *_h_bucketCounts = NULL;
+    // Number of threads, for which memory is allocated
+    uint_t _numThreads = 0;
+
+    /*
+    Allocates memory, which depends on number of threads.
+    */
+    void threadMemoryAllocate(uint_t numThreads)
+    {
+        uint_t maxNumSamples = max(numSamplesKo, numSamplesKv);
+        uint_t maxNumBuckets = max(numSplittersKo, numSplittersKv) + 1;
+
+        _h_samplesThreads = (data_t*)trackedMalloc(numThreads * maxNumSamples * sizeof(*_h_samplesThreads));
+        checkMallocError(_h_samplesThreads);
+        _h_bucketCounts = (uint_t*)trackedMalloc(numThreads * maxNumBuckets * sizeof(*_h_bucketCounts));
+        checkMallocError(_h_bucketCounts);
+
+        _numThreads = numThreads;
+    }
+
+    /*
+    Destroys memory, which depends on number of threads.
+    */
+    void threadMemoryDestroy()
+    {
+        if (_numThreads == 0)
+        {
+            return;
+        }
+
+        trackedFree(_h_samplesThreads);
+        trackedFree(_h_bucketCounts);
+        _numThreads = 0;
+    }
+
+    /*
+    Method for allocating memory needed both for key only and key-value sort.
+    */
+    virtual void memoryAllocate(data_t *h_keys, data_t *h_values, uint_t arrayLength)
+    {
+        SampleSortSequentialParent<
+            numSplittersKo, numSplittersKv, numSamplesKo, numSamplesKv, oversamplingFactorKo, oversamplingFactorKv,
+            smallSortThresholdKo, smallSortThresholdKv
+        >::memoryAllocate(h_keys, h_values, arrayLength);
+
+        threadMemoryDestroy();
+        threadMemoryAllocate(getNumThreads());
+    }
+
+    /*
+    If number of threads changed since memory allocation, memory of threads is reallocated.
+    */
+    virtual void memoryCopyBeforeSort(data_t *h_keys, data_t *h_values, uint_t arrayLength)
+    {
+        SampleSortSequentialParent<
+            numSplittersKo, numSplittersKv, numSamplesKo, numSamplesKv, oversamplingFactorKo, oversamplingFactorKv,
+            smallSortThresholdKo, smallSortThresholdKv
+        >::memoryCopyBeforeSort(h_keys, h_values, arrayLength);
+
+        if (_numThreads != getNumThreads())
+        {
+            threadMemoryDestroy();
+            threadMemoryAllocate(getNumThreads());
+        }
+    }
+
+    /*
+    Every thread collects and sorts it's part of samples. Sorted parts are merged afterwards.
+    */
+    template <order_t sortOrder>
+    void collectSamplesMultithreaded(
+        data_t *h_keys, data_t *h_samples, uint_t numSamples, uint_t numThreads, uint_t arrayLength
+    )
+    {
+        TRACE_SCOPE("sample sort sampling");
+        auto seed = std::chrono::high_resolution_clock::now().time_since_epoch().count();
+
+        parallelFor(numThreads, [&](uint_t threadIndex) {
+            uint_t samplesStart = numSamples * threadIndex / numThreads;
+            uint_t samplesEnd = numSamples * (threadIndex + 1) / numThreads;
+            auto generator = std::bind(
+                std::uniform_int_distribution<uint_t>(0, arrayLength - 1), std::mt19937(seed + threadIndex)
+            );
+
+            for (uint_t i = samplesStart; i < samplesEnd; i++)
+            {
+                h_samples[i] = h_keys[generator()];
+            }
+
+            if (sortOrder == ORDER_ASC)
+            {
+                std::sort(h_samples + samplesStart, h_samples + samplesEnd);
+            }
+            else
+            {
+                std::sort(h_samples + samplesStart, h_samples + samplesEnd, std::greater<data_t>());
+            }
+        });
+
+        // Merges sorted parts of samples
+        for (uint_t width = 1; width < numThreads; width *= 2)
+        {
+            for (uint_t part = 0; part + width < numThreads; part += 2 * width)
+            {
+                data_t *start = h_samples + numSamples * part / numThreads;
+                data_t *middle = h_samples + numSamples * (part + width) / numThreads;
+                data_t *end = h_samples + numSamples * min(part + 2 * width, numThreads) / numThreads;
+
+                if (sortOrder == ORDER_ASC)
+                {
+                    std::inplace_merge(start, middle, end);
+                }
+                else
+                {
+                    std::inplace_merge(start, middle, end, std::greater<data_t>());
+                }
+            }
+        }
+    }
+
+    /*
+    Performs EXCLUSIVE scan over bucket counts of all threads. Counts are scanned in bucket-major order (all
+    threads for bucket 0, all threads for bucket 1, ...), so elements of the same bucket keep the order of threads.
+    Every thread scans it's own range of buckets.
+    */
+    void exclusiveScanMultithreaded(uint_t *bucketCounts, uint_t numBuckets, uint_t numThreads)
+    {
+        TRACE_SCOPE("sample sort scan");
+        std::vector<uint_t> rangeSums(numThreads);
+
+        parallelFor(numThreads, [&](uint_t threadIndex) {
+            uint_t sum = 0;
+
+            for (uint_t bucket = numBuckets * threadIndex / numThreads;
+                 bucket < numBuckets * (threadIndex + 1) / numThreads; bucket++)
+            {
+                for (uint_t t = 0; t < numThreads; t++)
+                {
+                    sum += bucketCounts[t * numBuckets + bucket];
+                }
+            }
+
+            rangeSums[threadIndex] = sum;
+        });
+
+        this->exclusiveScan(rangeSums.data(), numThreads);
+
+        parallelFor(numThreads, [&](uint_t threadIndex) {
+            uint_t offset = rangeSums[threadIndex];
+
+            for (uint_t bucket = numBuckets * threadIndex / numThreads;
+                 bucket < numBuckets * (threadIndex + 1) / numThreads; bucket++)
+            {
+                for (uint_t t = 0; t < numThreads; t++)
+                {
+                    uint_t count = bucketCounts[t * numBuckets + bucket];
+                    bucketCounts[t * numBuckets + bucket] = offset;
+                    offset += count;
+                }
+            }
+        });
+    }
+
+    /*
+    Sorts array with multithreaded sample sort and outputs sorted data to result array.
+    Buckets, which are bigger than "arrayLength / numThreads", are sorted with all threads. Other buckets are
+    distributed among threads and every thread sorts it's buckets with sequential sample sort.
+    */
+    template <
+        order_t sortOrder, bool sortingKeyOnly, uint_t numSplitters, uint_t oversamplingFactor,
+        uint_t smallSortThreshold
+    >
+    void sampleSortMultithreaded(
+        data_t *h_keys, data_t *h_values, data_t *h_keysBuffer, data_t *h_valuesBuffer, data_t *h_keysSorted,
+        data_t *h_valuesSorted, data_t *h_samples, uint8_t *h_elementBuckets, uint_t *bucketCounts,
+        uint_t numThreads, uint_t arrayLength
+    )
+    {
+        const uint_t numSamples = numSplitters * oversamplingFactor;
+
+        if (arrayLength <= smallSortThreshold || numThreads == 1)
+        {
+            this->template sampleSortSequential<
+                sortOrder, sortingKeyOnly, numSplitters, oversamplingFactor, smallSortThreshold
+            >(
+                h_keys, h_values, h_keysBuffer, h_valuesBuffer, h_keysSorted, h_valuesSorted, h_samples,
+                h_elementBuckets, arrayLength
+            );
+            return;
+        }
+
+        collectSamplesMultithreaded<sortOrder>(h_keys, h_samples, numSamples, numThreads, arrayLength);
+
+        // Implicit binary search tree of splitters (index 0 is not used)
+        data_t splitterTree[numSplitters + 1];
+        // Needed only if splitters contain duplicates
+        uint_t bucketBases[numSplitters + 1];
+        uint8_t isSplitterDuplicated[numSplitters + 1];
+        bool isEqualityBucket[numSplitters + 1];
+        // For clarity purposes another pointer is used
+        data_t *splitters = h_samples;
+
+        for (uint_t i = 0; i < numSplitters; i++)
+        {
+            splitters[i] = h_samples[i * oversamplingFactor + (oversamplingFactor / 2)];
+        }
+
+        bool useEqualityBuckets = std::adjacent_find(splitters, splitters + numSplitters) != splitters + numSplitters;
+        uint_t numBuckets = numSplitters + 1;
+        if (useEqualityBuckets)
+        {
+            numBuckets = this->template buildEqualityBuckets<numSplitters>(
+                splitters, bucketBases, isSplitterDuplicated, isEqualityBucket
+            );
+        }
+        this->template buildSplitterTree<numSplitters>(splitters, splitterTree);
+
+        // Every thread classifies it's chunk of array and counts the elements in buckets
+        parallelFor(numThreads, [&](uint_t threadIndex) {
+            uint_t chunkStart = (uint_t)((uint64_t)arrayLength * threadIndex / numThreads);
+            uint_t chunkEnd = (uint_t)((uint64_t)arrayLength * (threadIndex + 1) / numThreads);
+            uint_t *threadBucketCounts = bucketCounts + threadIndex * numBuckets;
+
+            for (uint_t bucket = 0; bucket < numBuckets; bucket++)
+            {
+                threadBucketCounts[bucket] = 0;
+            }
+
+            if (useEqualityBuckets)
+            {
+                this->template classifyElements<sortOrder, numSplitters, true>(
+                    h_keys + chunkStart, splitterTree, splitters, bucketBases, isSplitterDuplicated,
+                    threadBucketCounts, h_elementBuckets + chunkStart, chunkEnd - chunkStart
+                );
+            }
+            else
+            {
+                this->template classifyElements<sortOrder, numSplitters, false>(
+                    h_keys + chunkStart, splitterTree, NULL, NULL, NULL, threadBucketCounts,
+                    h_elementBuckets + chunkStart, chunkEnd - chunkStart
+                );
+            }
+        });
+
+        exclusiveScanMultithreaded(bucketCounts, numBuckets, numThreads);
+
+        // Every thread stores elements of it's chunk in their corresponding buckets
+        parallelFor(numThreads, [&](uint_t threadIndex) {
+            uint_t chunkStart = (uint_t)((uint64_t)arrayLength * threadIndex / numThreads);
+            uint_t chunkEnd = (uint_t)((uint64_t)arrayLength * (threadIndex + 1) / numThreads);
+            uint_t *bucketOffsets = bucketCounts + threadIndex * numBuckets;
+            TRACE_SCOPE_SIZED("sample sort relocation", "length", chunkEnd - chunkStart, chunkEnd - chunkStart);
+
+            for (uint_t i = chunkStart; i < chunkEnd; i++)
+            {
+                uint_t *bucketOffset = &bucketOffsets[h_elementBuckets[i]];
+                h_keysBuffer[*bucketOffset] = h_keys[i];
+
+                if (!sortingKeyOnly)
+                {
+                    h_valuesBuffer[*bucketOffset] = h_values[i];
+                }
+
+                (*bucketOffset)++;
+            }
+        });
+
+        // After relocation offsets of the last thread point to the ends of buckets
+        uint_t bucketEnds[numSplitters + 1];
+        std::copy(
+            bucketCounts + (numThreads - 1) * numBuckets, bucketCounts + numThreads * numBuckets, bucketEnds
+        );
+
+        // Recursively sorts buckets. Equality buckets and small buckets are processed by threads afterwards.
+        std::vector<uint_t> sequentialBuckets;
+        for (uint_t i = 0; i < numBuckets; i++)
+        {
+            uint_t prevBucketOffset = i > 0 ? bucketEnds[i - 1] : 0;
+            uint_t bucketSize = bucketEnds[i] - prevBucketOffset;
+
+            if (bucketSize == 0)
+            {
+                continue;
+            }
+
+            if (bucketSize > arrayLength / numThreads && !(useEqualityBuckets && isEqualityBucket[i]))
+            {
+                // Primary and buffer arrays are exchanged
+                sampleSortMultithreaded<
+                    sortOrder, sortingKeyOnly, numSplitters, oversamplingFactor, smallSortThreshold
+                >(
+                    h_keysBuffer + prevBucketOffset, sortingKeyOnly ? NULL : h_valuesBuffer + prevBucketOffset,
+                    h_keys + prevBucketOffset, sortingKeyOnly ? NULL : h_values + prevBucketOffset,
+                    h_keysSorted + prevBucketOffset, sortingKeyOnly ? NULL : h_valuesSorted + prevBucketOffset,
+                    h_samples, h_elementBuckets + prevBucketOffset, bucketCounts, numThreads, bucketSize
+                );
+            }
+            else
+            {
+                sequentialBuckets.push_back(i);
+            }
+        }
+
+        // Small buckets are distributed among threads dynamically
+        std::atomic<uint_t> bucketCounter(0);
+        parallelFor(numThreads, [&](uint_t threadIndex) {
+            TRACE_SCOPE("sample sort small buckets");
+            uint_t i;
+
+            while ((i = bucketCounter++) < sequentialBuckets.size())
+            {
+                uint_t bucket = sequentialBuckets[i];
+                uint_t prevBucketOffset = bucket > 0 ? bucketEnds[bucket - 1] : 0;
+                uint_t bucketSize = bucketEnds[bucket] - prevBucketOffset;
+
+                if (useEqualityBuckets && isEqualityBucket[bucket])
+                {
+                    this->template copyEqualityBucket<sortingKeyOnly>(
+                        h_keysBuffer, h_valuesBuffer, h_keysSorted, h_valuesSorted, prevBucketOffset, bucketSize
+                    );
+                    continue;
+                }
+
+                // Primary and buffer arrays are exchanged
+                this->template sampleSortSequential<
+                    sortOrder, sortingKeyOnly, numSplitters, oversamplingFactor, smallSortThreshold
+                >(
+                    h_keysBuffer + prevBucketOffset, sortingKeyOnly ? NULL : h_valuesBuffer + prevBucketOffset,
+                    h_keys + prevBucketOffset, sortingKeyOnly ? NULL : h_values + prevBucketOffset,
+                    h_keysSorted + prevBucketOffset, sortingKeyOnly ? NULL : h_valuesSorted + prevBucketOffset,
+                    h_samples + threadIndex * numSamples, h_elementBuckets + prevBucketOffset, bucketSize
+                );
+            }
+        });
+    }
+
+    /*
+    Wrapper for multithreaded sample sort method.
+    The code runs faster if arguments are passed to method. If members are accessed directly, code runs slower.
+    */
+    void sortKeyOnly()
+    {
+        if (this->_sortOrder == ORDER_ASC)
+        {
+            sampleSortMultithreaded<ORDER_ASC, true, numSplittersKo, oversamplingFactorKo, smallSortThresholdKo>(
+                this->_h_keys, NULL, this->_h_keysBuffer, NULL, this->_h_keysSorted, NULL, _h_samplesThreads,
+                this->_h_elementBuckets, _h_bucketCounts, _numThreads, this->_arrayLength
+            );
+        }
+        else
+        {
+            sampleSortMultithreaded<ORDER_DESC, true, numSplittersKo, oversamplingFactorKo, smallSortThresholdKo>(
+                this->_h_keys, NULL, this->_h_keysBuffer, NULL, this->_h_keysSorted, NULL, _h_samplesThreads,
+                this->_h_elementBuckets, _h_bucketCounts, _numThreads, this->_arrayLength
+            );
+        }
+    }
+
+    /*
+    Wrapper for multithreaded sample sort method.
+    The code runs faster if arguments are passed to method. If members are accessed directly, code runs slower.
+    */
+    void sortKeyValue()
+    {
+        if (this->_sortOrder == ORDER_ASC)
+        {
+            sampleSortMultithreaded<ORDER_ASC, false, numSplittersKv, oversamplingFactorKv, smallSortThresholdKv>(
+                this->_h_keys, this->_h_values, this->_h_keysBuffer, this->_h_valuesBuffer, this->_h_keysSorted,
+                this->_h_valuesSorted, _h_samplesThreads, this->_h_elementBuckets, _h_bucketCounts, _numThreads,
+                this->_arrayLength
+            );
+        }
+        else
+        {
+            sampleSortMultithreaded<ORDER_DESC, false, numSplittersKv, oversamplingFactorKv, smallSortThresholdKv>(
+                this->_h_keys, this->_h_values, this->_h_keysBuffer, this->_h_valuesBuffer, this->_h_keysSorted,
+                this->_h_valuesSorted, _h_samplesThreads, this->_h_elementBuckets, _h_bucketCounts, _numThreads,
+                this->_arrayLength
+            );
+        }
+    }
+
+public:
+    std::string getSortName()
+    {
+        return this->_sortName;
+    }
+
+    /*
+    Method for destroying memory needed for sort. For sort testing purposes this method is public.
+    */
+    void memoryDestroy()
+    {
+        if (this->_arrayLength == 0)
+        {
+            return;
+        }
+
+        SampleSortSequentialParent<
+            numSplittersKo, numSplittersKv, numSamplesKo, numSamplesKv, oversamplingFactorKo, oversamplingFactorKv,
+            smallSortThresholdKo, smallSortThresholdKv
+        >::memoryDestroy();
+        threadMemoryDestroy();
+    }
+};
+
+/*
+Base class for multithreaded sample sort.
+*/
+template <
+    uint_t numSplittersKo, uint_t numSplittersKv,
+    uint_t oversamplingFactorKo, uint_t oversamplingFactorKv,
+    uint_t smallSortThresholdKo, uint_t smallSortThresholdKv
+>
+class SampleSortMultithreadedBase : public SampleSortMultithreadedParent<
+    numSplittersKo, numSplittersKv,
+    numSplittersKo * oversamplingFactorKo, numSplittersKv * oversamplingFactorKv,
+    oversamplingFactorKo, oversamplingFactorKv,
+    smallSortThresholdKo, smallSortThresholdKv
+>
+{};
+
+/*
+Class for multithreaded sample sort.
+*/
+class SampleSortMultithreaded : public SampleSortMultithreadedBase<
+    NUM_SPLITTERS_SEQUENTIAL_KO, NUM_SPLITTERS_SEQUENTIAL_KV,
+    OVERSAMPLING_FACTOR_KO, OVERSAMPLING_FACTOR_KV,
+    SMALL_SORT_THRESHOLD_KO, SMALL_SORT_THRESHOLD_KV
+>
+{};
+
+#endif
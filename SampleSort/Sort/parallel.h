@@ -514,13 +514,13 @@ public:
 Class for parallel bitonic sort.
 */
 class SampleSortParallel : public SampleSortParallelBase<
-    THREADS_PADDING, ELEMS_PADDING,
-    THREADS_BITONIC_SORT_KO, ELEMS_BITONIC_SORT_KO,
-    THREADS_BITONIC_SORT_KV, ELEMS_BITONIC_SORT_KV,
-    THREADS_GLOBAL_MERGE_KO, ELEMS_GLOBAL_MERGE_KO,
-    THREADS_GLOBAL_MERGE_KV, ELEMS_GLOBAL_MERGE_KV,
-    THREADS_LOCAL_MERGE_KO, ELEMS_LOCAL_MERGE_KO,
-    THREADS_LOCAL_MERGE_KV, ELEMS_LOCAL_MERGE_KV,
+    SAMPLE_THREADS_PADDING, SAMPLE_ELEMS_PADDING,
+    SAMPLE_THREADS_BITONIC_SORT_KO, SAMPLE_ELEMS_BITONIC_SORT_KO,
+    SAMPLE_THREADS_BITONIC_SORT_KV, SAMPLE_ELEMS_BITONIC_SORT_KV,
+    SAMPLE_THREADS_GLOBAL_MERGE_KO, SAMPLE_ELEMS_GLOBAL_MERGE_KO,
+    SAMPLE_THREADS_GLOBAL_MERGE_KV, SAMPLE_ELEMS_GLOBAL_MERGE_KV,
+    SAMPLE_THREADS_LOCAL_MERGE_KO, SAMPLE_ELEMS_LOCAL_MERGE_KO,
+    SAMPLE_THREADS_LOCAL_MERGE_KV, SAMPLE_ELEMS_LOCAL_MERGE_KV,
     THREADS_SAMPLE_INDEXING_KO, THREADS_SAMPLE_INDEXING_KV,
     THREADS_BUCKETS_RELOCATION_KO, THREADS_BUCKETS_RELOCATION_KV,
     NUM_SAMPLES_PARALLEL_KO, NUM_SAMPLES_PARALLEL_KV
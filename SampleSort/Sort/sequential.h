@@ -7,10 +7,13 @@
 #include <random>
 #include <functional>
 #include <chrono>
+#include <algorithm>
 
 #include "../../Utils/data_types_common.h"
 #include "../../Utils/sort_correct.h"
 #include "../../Utils/host.h"
+#include "../../Utils/allocation.h"
+#include "../../Utils/trace.h"
 #include "../../MergeSort/Sort/sequential.h"
 #include "../constants.h"
 
@@ -31,6 +34,19 @@ template <
 >
 class SampleSortSequentialParent : public MergeSortSequential
 {
+    static_assert(
+        ((numSplittersKo + 1) & numSplittersKo) == 0 && ((numSplittersKv + 1) & numSplittersKv) == 0,
+        "Number of buckets in sequential sample sort has to be power of 2."
+    );
+    static_assert(
+        numSplittersKo < 256 && numSplittersKv < 256,
+        "Number of buckets in sequential sample sort has to fit into one byte."
+    );
+    static_assert(
+        numSamplesKo > numSplittersKo && numSamplesKv > numSplittersKv,
+        "Number of samples in sequential sample sort has to be greater than number of splitters."
+    );
+
 protected:
     std::string _sortName = "Sample sort sequential";
 
@@ -39,8 +55,9 @@ protected:
     data_t *_h_keysSorted = NULL, *_h_valuesSorted = NULL;
     // Holds samples and after samples are sorted holds splitters in sequential sample sort
     data_t *_h_samples;
-    // For every element in input holds bucket index to which it belongs (needed for sequential sample sort)
-    uint_t *_h_elementBuckets;
+    // For every element in input holds bucket index to which it belongs (needed for sequential sample sort).
+    // Number of buckets is limited to 256, so one byte per element is enough.
+    uint8_t *_h_elementBuckets;
 
     /*
     Method for allocating memory needed both for key only and key-value sort.
@@ -51,16 +68,16 @@ protected:
 
         uint_t maxNumSamples = max(numSamplesKo, numSamplesKv);
 
-        _h_keysSorted = (data_t*)malloc(arrayLength * sizeof(*_h_keysSorted));
+        _h_keysSorted = (data_t*)trackedMalloc(arrayLength * sizeof(*_h_keysSorted));
         checkMallocError(_h_keysSorted);
-        _h_valuesSorted = (data_t*)malloc(arrayLength * sizeof(*_h_valuesSorted));
+        _h_valuesSorted = (data_t*)trackedMalloc(arrayLength * sizeof(*_h_valuesSorted));
         checkMallocError(_h_valuesSorted);
 
         // Holds samples and splitters in sequential sample sort (needed for sequential sample sort)
-        _h_samples = (data_t*)malloc(maxNumSamples * sizeof(*_h_samples));
+        _h_samples = (data_t*)trackedMalloc(maxNumSamples * sizeof(*_h_samples));
         checkMallocError(_h_samples);
         // For each element in array holds, to which bucket it belongs (needed for sequential sample sort)
-        _h_elementBuckets = (uint_t*)malloc(arrayLength * sizeof(*_h_elementBuckets));
+        _h_elementBuckets = (uint8_t*)trackedMalloc(arrayLength * sizeof(*_h_elementBuckets));
         checkMallocError(_h_elementBuckets);
     }
 
@@ -91,6 +108,7 @@ protected:
     template <order_t sortOrder, bool sortingKeyOnly>
     void collectSamples(data_t *d_keys, data_t *h_samples, uint_t arrayLength)
     {
+        TRACE_SCOPE_SIZED("sample sort sampling", "length", arrayLength, arrayLength);
         auto seed = std::chrono::high_resolution_clock::now().time_since_epoch().count();
         auto generator = std::bind(std::uniform_int_distribution<uint_t>(0, arrayLength - 1), std::mt19937(seed));
         uint_t numSamples = sortingKeyOnly ? numSamplesKo : numSamplesKv;
@@ -106,29 +124,163 @@ protected:
     }
 
     /*
-    Performs inclusive binary search and returns index where element should be located.
+    Builds implicit binary search tree out of sorted splitters. Root of the tree is located at index 1 and children
+    of node "j" are located at indexes "2 * j" and "2 * j + 1". Index 0 is not used.
+    */
+    template <uint_t numSplitters>
+    void buildSplitterTree(data_t *splitters, data_t *splitterTree)
+    {
+        uint_t numBuckets = numSplitters + 1;
+
+        for (uint_t levelSize = 1; levelSize < numBuckets; levelSize <<= 1)
+        {
+            // Stride between splitters, which are placed on current level of the tree
+            uint_t stride = numBuckets / levelSize;
+
+            for (uint_t node = 0; node < levelSize; node++)
+            {
+                splitterTree[levelSize + node] = splitters[node * stride + stride / 2 - 1];
+            }
+        }
+    }
+
+    /*
+    If sorted splitters contain duplicates, removes them and creates an equality bucket for every duplicated
+    splitter. Elements equal to duplicated splitter are stored in it's equality bucket, which doesn't need any
+    further sorting. Unique splitters are padded with the last unique splitter, so the splitter tree keeps it's
+    size. For every bucket of the splitter tree "bucketBases" holds index of output bucket and "isSplitterDuplicated"
+    holds 1, if equality bucket follows it. Splitter with index "numSplitters" has to be readable.
+    Returns number of output buckets, which is never greater than "numSplitters + 1".
     */
-    template <order_t sortOrder>
-    int binarySearchInclusive(data_t* h_keys, data_t target, uint_t arrayLength)
+    template <uint_t numSplitters>
+    uint_t buildEqualityBuckets(
+        data_t *splitters, uint_t *bucketBases, uint8_t *isSplitterDuplicated, bool *isEqualityBucket
+    )
     {
-        int_t indexStart = 0;
-        int_t indexEnd = arrayLength - 1;
+        uint_t numUniqueSplitters = 0;
+
+        for (uint_t i = 0; i < numSplitters; i++)
+        {
+            if (numUniqueSplitters > 0 && splitters[i] == splitters[numUniqueSplitters - 1])
+            {
+                isSplitterDuplicated[numUniqueSplitters - 1] = 1;
+                continue;
+            }
+
+            splitters[numUniqueSplitters] = splitters[i];
+            isSplitterDuplicated[numUniqueSplitters] = 0;
+            numUniqueSplitters++;
+        }
 
-        while (indexStart <= indexEnd)
+        // Buckets of padded splitters stay empty, because elements equal to last unique splitter end up in it's
+        // bucket (inclusive search). Every duplicated splitter frees at least one slot, so number of output buckets
+        // stays within "numSplitters + 1".
+        for (uint_t i = numUniqueSplitters; i <= numSplitters; i++)
+        {
+            splitters[i] = splitters[numUniqueSplitters - 1];
+            isSplitterDuplicated[i] = 0;
+        }
+
+        uint_t numBuckets = 0;
+        for (uint_t i = 0; i <= numSplitters; i++)
         {
-            int index = (indexStart + indexEnd) / 2;
+            bucketBases[i] = numBuckets;
 
-            if (sortOrder == ORDER_ASC ? (target <= h_keys[index]) : (target >= h_keys[index]))
+            // Empty buckets of padded splitters don't need output buckets
+            if (i >= numUniqueSplitters && i < numSplitters)
             {
-                indexEnd = index - 1;
+                continue;
             }
-            else
+
+            isEqualityBucket[numBuckets++] = false;
+
+            if (isSplitterDuplicated[i])
             {
-                indexStart = index + 1;
+                isEqualityBucket[numBuckets++] = true;
             }
         }
 
-        return indexStart;
+        return numBuckets;
+    }
+
+    /*
+    For every element determines, which bucket it belongs to and counts the elements in buckets. Elements are
+    classified with descent through the splitter tree, which doesn't contain any branches. This way there are no
+    branch mispredictions. Multiple elements are classified at the same time in order to expose instruction-level
+    parallelism, because tree descents of different elements are independent from each other.
+
+    Element belongs to bucket "i", if "splitter[i - 1] < element <= splitter[i]" (for ascending order). This is
+    the same as inclusive binary search over splitters. If equality buckets are used, bucket of the tree is
+    additionally mapped to output bucket (see "buildEqualityBuckets").
+    */
+    template <order_t sortOrder, uint_t numSplitters, bool useEqualityBuckets>
+    void classifyElements(
+        data_t *h_keys, data_t *splitterTree, data_t *splitters, uint_t *bucketBases, uint8_t *isSplitterDuplicated,
+        uint_t *bucketSizes, uint8_t *h_elementBuckets, uint_t arrayLength
+    )
+    {
+        TRACE_SCOPE_SIZED("sample sort classification", "length", arrayLength, arrayLength);
+        const uint_t numTreeBuckets = numSplitters + 1;
+        const uint_t unroll = CLASSIFICATION_UNROLL_SEQUENTIAL;
+        uint_t index = 0;
+
+        for (; index + unroll <= arrayLength; index += unroll)
+        {
+            uint_t nodes[unroll];
+
+            for (uint_t u = 0; u < unroll; u++)
+            {
+                nodes[u] = 1;
+            }
+
+            for (uint_t levelSize = 1; levelSize < numTreeBuckets; levelSize <<= 1)
+            {
+                for (uint_t u = 0; u < unroll; u++)
+                {
+                    data_t key = h_keys[index + u];
+                    data_t splitter = splitterTree[nodes[u]];
+                    nodes[u] = 2 * nodes[u] + (sortOrder == ORDER_ASC ? key > splitter : key < splitter);
+                }
+            }
+
+            for (uint_t u = 0; u < unroll; u++)
+            {
+                uint_t bucket = nodes[u] - numTreeBuckets;
+
+                if (useEqualityBuckets)
+                {
+                    bucket = bucketBases[bucket] + (
+                        isSplitterDuplicated[bucket] & (h_keys[index + u] == splitters[bucket])
+                    );
+                }
+
+                bucketSizes[bucket]++;
+                h_elementBuckets[index + u] = bucket;
+            }
+        }
+
+        // Classifies remaining elements, which don't fill the whole unrolled group
+        for (; index < arrayLength; index++)
+        {
+            data_t key = h_keys[index];
+            uint_t node = 1;
+
+            for (uint_t levelSize = 1; levelSize < numTreeBuckets; levelSize <<= 1)
+            {
+                data_t splitter = splitterTree[node];
+                node = 2 * node + (sortOrder == ORDER_ASC ? key > splitter : key < splitter);
+            }
+
+            uint_t bucket = node - numTreeBuckets;
+
+            if (useEqualityBuckets)
+            {
+                bucket = bucketBases[bucket] + (isSplitterDuplicated[bucket] & (key == splitters[bucket]));
+            }
+
+            bucketSizes[bucket]++;
+            h_elementBuckets[index] = bucket;
+        }
     }
 
     /*
@@ -148,32 +300,45 @@ protected:
     }
 
     /*
-    Sorts array with sample sort and outputs sorted data to result array.
+    Copies elements of equality bucket from buffer array to sorted array.
     */
-    template <
-        order_t sortOrder, uint_t sortingKeyOnly, uint_t numSplitters, uint_t oversamplingFactor,
-        uint_t smallSortThreashold
-    >
-    void sampleSortSequential(
-        data_t *h_keys, data_t *h_values, data_t *h_keysBuffer, data_t *h_valuesBuffer, data_t *h_keysSorted,
-        data_t *h_valuesSorted, data_t *h_samples, uint_t *h_elementBuckets, uint_t arrayLength
+    template <bool sortingKeyOnly>
+    void copyEqualityBucket(
+        data_t *h_keysBuffer, data_t *h_valuesBuffer, data_t *h_keysSorted, data_t *h_valuesSorted,
+        uint_t bucketOffset, uint_t bucketSize
     )
     {
-        // When array is small enough, it is sorted with small sort (in our case merge sort).
-        // Merge sort was chosen because it is stable sort and it keeps sorted array stable.
-        if (arrayLength <= smallSortThreashold)
+        std::copy(h_keysBuffer + bucketOffset, h_keysBuffer + bucketOffset + bucketSize, h_keysSorted + bucketOffset);
+
+        if (!sortingKeyOnly)
         {
-            mergeSortSequential<sortOrder, sortingKeyOnly>(
-                h_keys, h_values, h_keysBuffer, h_valuesBuffer, h_keysSorted, h_valuesSorted, arrayLength
+            std::copy(
+                h_valuesBuffer + bucketOffset, h_valuesBuffer + bucketOffset + bucketSize,
+                h_valuesSorted + bucketOffset
             );
-            return;
         }
+    }
 
+    /*
+    Distributes array into buckets, which are stored in buffer array. Returns number of buckets. After distribution
+    "bucketOffsets" holds the end offset of every bucket and "isEqualityBucket" denotes buckets, which contain only
+    elements equal to the same splitter and don't need any further sorting. Distribution is stable.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly, uint_t numSplitters, uint_t oversamplingFactor>
+    uint_t distributeElements(
+        data_t *h_keys, data_t *h_values, data_t *h_keysBuffer, data_t *h_valuesBuffer, data_t *h_samples,
+        uint8_t *h_elementBuckets, uint_t *bucketOffsets, bool *isEqualityBucket, uint_t arrayLength
+    )
+    {
         collectSamples<sortOrder, sortingKeyOnly>(h_keys, h_samples, arrayLength);
 
-        // Holds bucket sizes and bucket offsets after exclusive scan is performed on bucket sizes.
-        // A new array is needed for every level of recursion.
-        uint_t bucketSizes[numSplitters + 1];
+        // Holds bucket sizes and bucket offsets after exclusive scan is performed on bucket sizes
+        uint_t *bucketSizes = bucketOffsets;
+        // Implicit binary search tree of splitters (index 0 is not used)
+        data_t splitterTree[numSplitters + 1];
+        // Needed only if splitters contain duplicates
+        uint_t bucketBases[numSplitters + 1];
+        uint8_t isSplitterDuplicated[numSplitters + 1];
         // For clarity purposes another pointer is used
         data_t *splitters = h_samples;
 
@@ -182,22 +347,43 @@ protected:
         {
             splitters[i] = h_samples[i * oversamplingFactor + (oversamplingFactor / 2)];
             bucketSizes[i] = 0;
+            isEqualityBucket[i] = false;
         }
         // For "numSplitters" splitters "numSplitters + 1" buckets are created
         bucketSizes[numSplitters] = 0;
+        isEqualityBucket[numSplitters] = false;
+
+        // If there are many duplicates in array, then splitters contain duplicates too. In that case equality
+        // buckets are created, otherwise elements equal to splitter would be sorted again on next level of recursion.
+        bool useEqualityBuckets = std::adjacent_find(splitters, splitters + numSplitters) != splitters + numSplitters;
+        uint_t numBuckets = numSplitters + 1;
+        if (useEqualityBuckets)
+        {
+            numBuckets = buildEqualityBuckets<numSplitters>(
+                splitters, bucketBases, isSplitterDuplicated, isEqualityBucket
+            );
+        }
 
         // For all elements in data table searches, which bucket they belong to and counts the elements in buckets
-        for (uint_t i = 0; i < arrayLength; i++)
+        buildSplitterTree<numSplitters>(splitters, splitterTree);
+        if (useEqualityBuckets)
         {
-            uint_t bucket = binarySearchInclusive<sortOrder>(splitters, h_keys[i], numSplitters);
-            bucketSizes[bucket]++;
-            h_elementBuckets[i] = bucket;
+            classifyElements<sortOrder, numSplitters, true>(
+                h_keys, splitterTree, splitters, bucketBases, isSplitterDuplicated, bucketSizes, h_elementBuckets,
+                arrayLength
+            );
+        }
+        else
+        {
+            classifyElements<sortOrder, numSplitters, false>(
+                h_keys, splitterTree, NULL, NULL, NULL, bucketSizes, h_elementBuckets, arrayLength
+            );
         }
 
+        TRACE_SCOPE_SIZED("sample sort relocation", "length", arrayLength, arrayLength);
+
         // Performs an EXCLUSIVE scan over array of bucket sizes in order to get bucket offsets
-        exclusiveScan(bucketSizes, numSplitters + 1);
-        // For clarity purposes another pointer is used
-        uint_t *bucketOffsets = bucketSizes;
+        exclusiveScan(bucketSizes, numBuckets);
 
         // Goes through all elements again and stores them in their corresponding buckets
         for (uint_t i = 0; i < arrayLength; i++)
@@ -213,19 +399,55 @@ protected:
             (*bucketOffset)++;
         }
 
-        // Recursively sorts buckets
-        for (uint_t i = 0; i <= numSplitters; i++)
+        return numBuckets;
+    }
+
+    /*
+    Sorts array with sample sort and outputs sorted data to result array.
+    */
+    template <
+        order_t sortOrder, uint_t sortingKeyOnly, uint_t numSplitters, uint_t oversamplingFactor,
+        uint_t smallSortThreashold
+    >
+    void sampleSortSequential(
+        data_t *h_keys, data_t *h_values, data_t *h_keysBuffer, data_t *h_valuesBuffer, data_t *h_keysSorted,
+        data_t *h_valuesSorted, data_t *h_samples, uint8_t *h_elementBuckets, uint_t arrayLength
+    )
+    {
+        // When array is small enough, it is sorted with small sort (in our case merge sort).
+        // Merge sort was chosen because it is stable sort and it keeps sorted array stable.
+        if (arrayLength <= smallSortThreashold)
+        {
+            mergeSortSequential<sortOrder, sortingKeyOnly>(
+                h_keys, h_values, h_keysBuffer, h_valuesBuffer, h_keysSorted, h_valuesSorted, arrayLength
+            );
+            return;
+        }
+
+        // Holds bucket offsets. A new array is needed for every level of recursion.
+        uint_t bucketOffsets[numSplitters + 1];
+        bool isEqualityBucket[numSplitters + 1];
+
+        uint_t numBuckets = distributeElements<sortOrder, sortingKeyOnly, numSplitters, oversamplingFactor>(
+            h_keys, h_values, h_keysBuffer, h_valuesBuffer, h_samples, h_elementBuckets, bucketOffsets,
+            isEqualityBucket, arrayLength
+        );
+
+        // Recursively sorts buckets. Because splitters are taken from array, every splitter ends up in different
+        // bucket or in equality bucket. This way no bucket, which is sorted further, can contain the whole array.
+        TRACE_SCOPE_SIZED("sample sort recursion", "length", arrayLength, arrayLength);
+        for (uint_t i = 0; i < numBuckets; i++)
         {
             uint_t prevBucketOffset = i > 0 ? bucketOffsets[i - 1] : 0;
             uint_t bucketSize = bucketOffsets[i] - prevBucketOffset;
 
-            // Without this condition recursion would never end, if distribution was ZERO (all elements are same).
-            if (bucketSize == arrayLength)
+            // Elements in equality bucket are all the same and are already in stable order
+            if (isEqualityBucket[i])
             {
-                mergeSortSequential<sortOrder, sortingKeyOnly>(
-                    h_keysBuffer, h_valuesBuffer, h_keys, h_values, h_keysSorted, h_valuesSorted, arrayLength
+                copyEqualityBucket<sortingKeyOnly>(
+                    h_keysBuffer, h_valuesBuffer, h_keysSorted, h_valuesSorted, prevBucketOffset, bucketSize
                 );
-                return;
+                continue;
             }
 
             if (bucketSize > 0)
@@ -302,6 +524,33 @@ public:
         return this->_sortName;
     }
 
+    /*
+    Every distribution level reads keys twice (classification and relocation) and writes them once, values are
+    read and written once. Bucket index of every element is written and read once. Buckets on the last level are
+    sorted with merge sort. Distribution levels and merge phases are executed from main memory only while their
+    subarrays and buffers don't fit into last level cache.
+    */
+    double getBytesMoved()
+    {
+        bool sortingKeyOnly = _h_values == NULL;
+        uint_t numBuckets = (sortingKeyOnly ? numSplittersKo : numSplittersKv) + 1;
+        uint_t smallSortThreshold = sortingKeyOnly ? smallSortThresholdKo : smallSortThresholdKv;
+        double bucketLength;
+
+        double numLevels = getNumDistributionLevels(_arrayLength, numBuckets, smallSortThreshold, &bucketLength);
+        double numMergePhases = bucketLength > 1 ? log2((double)nextPowerOf2((uint_t)ceil(bucketLength))) : 0;
+        double numMemoryLevels = getNumMemoryLevels(
+            numLevels, numBuckets, 2 * getElementSize() + sizeof(*_h_elementBuckets)
+        );
+        bool isBucketInCache = bucketLength * 2 * getElementSize() <= getLastLevelCacheSize();
+        double numMemoryPhases = numMemoryLevels == numLevels && !isBucketInCache ? numMergePhases : 0;
+        double bytesBuckets = 2 * numMemoryLevels * _arrayLength * sizeof(*_h_elementBuckets);
+
+        return getBytesOfPasses(
+            3 * numMemoryLevels + 2 * numMemoryPhases, 2 * numMemoryLevels + 2 * numMemoryPhases
+        ) + bytesBuckets + getBytesOfCacheLevels(numLevels + numMergePhases, numMemoryLevels + numMemoryPhases);
+    }
+
     /*
     Method for destroying memory needed for sort. For sort testing purposes this method is public.
     */
@@ -314,10 +563,10 @@ public:
 
         MergeSortSequential::memoryDestroy();
 
-        free(_h_keysSorted);
-        free(_h_valuesSorted);
-        free(_h_samples);
-        free(_h_elementBuckets);
+        trackedFree(_h_keysSorted);
+        trackedFree(_h_valuesSorted);
+        trackedFree(_h_samples);
+        trackedFree(_h_elementBuckets);
     }
 };
 
@@ -12,9 +12,9 @@ _KV: Key-value
 /* ------------------ PADDING KERNEL ----------------- */
 
 // How many threads are used per on thread block for padding. Has to be power of 2.
-#define THREADS_PADDING 128
+#define SAMPLE_THREADS_PADDING 128
 // How many table elements are processed by one thread in padding kernel. Min value is 2.
-#define ELEMS_PADDING 8
+#define SAMPLE_ELEMS_PADDING 8
 
 
 /* ---------------- BITONIC SORT KERNEL -------------- */
@@ -22,20 +22,20 @@ _KV: Key-value
 // How many threads are used per one thread block for bitonic sort, which is performed entirely
 // in shared memory. Has to be power of 2.
 #if DATA_TYPE_BITS == 32
-#define THREADS_BITONIC_SORT_KO 512
-#define THREADS_BITONIC_SORT_KV 256
+#define SAMPLE_THREADS_BITONIC_SORT_KO 512
+#define SAMPLE_THREADS_BITONIC_SORT_KV 256
 #else
-#define THREADS_BITONIC_SORT_KO 256
-#define THREADS_BITONIC_SORT_KV 256
+#define SAMPLE_THREADS_BITONIC_SORT_KO 256
+#define SAMPLE_THREADS_BITONIC_SORT_KV 256
 #endif
 // How many elements are processed by one thread in bitonic sort kernel. Min value is 2.
 // Has to be divisible by 2.
 #if DATA_TYPE_BITS == 32
-#define ELEMS_BITONIC_SORT_KO 4
-#define ELEMS_BITONIC_SORT_KV 4
+#define SAMPLE_ELEMS_BITONIC_SORT_KO 4
+#define SAMPLE_ELEMS_BITONIC_SORT_KV 4
 #else
-#define ELEMS_BITONIC_SORT_KO 4
-#define ELEMS_BITONIC_SORT_KV 2
+#define SAMPLE_ELEMS_BITONIC_SORT_KO 4
+#define SAMPLE_ELEMS_BITONIC_SORT_KV 2
 #endif
 
 
@@ -43,20 +43,20 @@ _KV: Key-value
 
 // How many threads are used per one thread block in GLOBAL bitonic merge. Has to be power of 2.
 #if DATA_TYPE_BITS == 32
-#define THREADS_GLOBAL_MERGE_KO 256
-#define THREADS_GLOBAL_MERGE_KV 128
+#define SAMPLE_THREADS_GLOBAL_MERGE_KO 256
+#define SAMPLE_THREADS_GLOBAL_MERGE_KV 128
 #else
-#define THREADS_GLOBAL_MERGE_KO 128
-#define THREADS_GLOBAL_MERGE_KV 128
+#define SAMPLE_THREADS_GLOBAL_MERGE_KO 128
+#define SAMPLE_THREADS_GLOBAL_MERGE_KV 128
 #endif
 // How many elements are processed by one thread in GLOBAL bitonic merge. Min value is 2.
 // Has to be divisable by 2.
 #if DATA_TYPE_BITS == 32
-#define ELEMS_GLOBAL_MERGE_KO 4
-#define ELEMS_GLOBAL_MERGE_KV 4
+#define SAMPLE_ELEMS_GLOBAL_MERGE_KO 4
+#define SAMPLE_ELEMS_GLOBAL_MERGE_KV 4
 #else
-#define ELEMS_GLOBAL_MERGE_KO 2
-#define ELEMS_GLOBAL_MERGE_KV 2
+#define SAMPLE_ELEMS_GLOBAL_MERGE_KO 2
+#define SAMPLE_ELEMS_GLOBAL_MERGE_KV 2
 #endif
 
 
@@ -64,20 +64,20 @@ _KV: Key-value
 
 // How many threads are used per one thread block in LOCAL bitonic merge. Has to be power of 2.
 #if DATA_TYPE_BITS == 32
-#define THREADS_LOCAL_MERGE_KO 512
-#define THREADS_LOCAL_MERGE_KV 256
+#define SAMPLE_THREADS_LOCAL_MERGE_KO 512
+#define SAMPLE_THREADS_LOCAL_MERGE_KV 256
 #else
-#define THREADS_LOCAL_MERGE_KO 512
-#define THREADS_LOCAL_MERGE_KV 512
+#define SAMPLE_THREADS_LOCAL_MERGE_KO 512
+#define SAMPLE_THREADS_LOCAL_MERGE_KV 512
 #endif
 // How many elements are processed by one thread in LOCAL bitonic merge. Min value is 2.
 // Has to be divisible by 2.
 #if DATA_TYPE_BITS == 32
-#define ELEMS_LOCAL_MERGE_KO 4
-#define ELEMS_LOCAL_MERGE_KV 4
+#define SAMPLE_ELEMS_LOCAL_MERGE_KO 4
+#define SAMPLE_ELEMS_LOCAL_MERGE_KV 4
 #else
-#define ELEMS_LOCAL_MERGE_KO 4
-#define ELEMS_LOCAL_MERGE_KV 2
+#define SAMPLE_ELEMS_LOCAL_MERGE_KO 4
+#define SAMPLE_ELEMS_LOCAL_MERGE_KV 2
 #endif
 
 
@@ -121,14 +121,19 @@ _KV: Key-value
 /* --------- SEQUENTIAL ALGORITHM PARAMETERS --------- */
 
 // How many splitters are used for buckets. From "N" splitters "N + 1" buckets are created.
+// "N + 1" has to be power of 2 and lower or equal than 256 (bucket index of element is saved in one byte).
 #if DATA_TYPE_BITS == 32
-#define NUM_SPLITTERS_SEQUENTIAL_KO 16
-#define NUM_SPLITTERS_SEQUENTIAL_KV 16
+#define NUM_SPLITTERS_SEQUENTIAL_KO 15
+#define NUM_SPLITTERS_SEQUENTIAL_KV 15
 #else
-#define NUM_SPLITTERS_SEQUENTIAL_KO 16
-#define NUM_SPLITTERS_SEQUENTIAL_KV 16
+#define NUM_SPLITTERS_SEQUENTIAL_KO 15
+#define NUM_SPLITTERS_SEQUENTIAL_KV 15
 #endif
 
+// How many elements are classified into buckets at the same time (classifications of different elements are
+// independent from each other, which enables instruction-level parallelism).
+#define CLASSIFICATION_UNROLL_SEQUENTIAL 8
+
 // How many extra samples are taken for every splitter. Increases the quality of splitters (samples
 // get sorted and only "NUM_SPLITTERS_SEQUENTIAL" splitters are taken from sorted array of samples).
 #if DATA_TYPE_BITS == 32
@@ -149,4 +154,17 @@ _KV: Key-value
 #define SMALL_SORT_THRESHOLD_KV (1 << 14)
 #endif
 
+
+/* ----------- HYBRID ALGORITHM PARAMETERS ----------- */
+
+// Buckets, which are smaller or equal than threshold, are sorted with radix sort. Bucket together with buffer and
+// sorted array should fit into L2 cache (256 KB).
+#if DATA_TYPE_BITS == 32
+#define BUCKET_THRESHOLD_HYBRID_KO (1 << 14)
+#define BUCKET_THRESHOLD_HYBRID_KV (1 << 13)
+#else
+#define BUCKET_THRESHOLD_HYBRID_KO (1 << 13)
+#define BUCKET_THRESHOLD_HYBRID_KV (1 << 12)
+#endif
+
 #endif
@@ -0,0 +1,905 @@
+#ifndef SAMPLE_SORT_IN_PLACE_MULTITHREADED_H
+#define SAMPLE_SORT_IN_PLACE_MULTITHREADED_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <random>
+#include <chrono>
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+#include <functional>
+
+#include "../../Utils/data_types_common.h"
+#include "../../Utils/sort_interface.h"
+#include "../../Utils/sort_correct.h"
+#include "../../Utils/threads.h"
+#include "../../Utils/host.h"
+#include "../../Utils/allocation.h"
+#include "../../Utils/trace.h"
+#include "../constants.h"
+#include "../data_types.h"
+
+
+/*
+Parent class for multithreaded in-place super scalar sample sort (IPS4o). Not to be used directly - it's inherited
+by bottom class, which performs partial template specialization.
+
+Elements are classified into buckets in blocks. Every thread classifies it's stripe of array into buffer blocks
+and writes full blocks back to the beginning of it's stripe. After that blocks are permuted into their buckets
+in parallel, remaining elements from buffer blocks are written to bucket boundaries and buckets are sorted
+recursively. Besides array only O(numBuckets * blockSize) memory per thread is needed.
+
+Template params:
+_Ko - Key-only
+_Kv - Key-value
+*/
+template <
+    uint_t numSplittersKo, uint_t numSplittersKv,
+    uint_t blockSizeKo, uint_t blockSizeKv,
+    uint_t oversamplingFactorKo, uint_t oversamplingFactorKv,
+    uint_t smallSortThresholdKo, uint_t smallSortThresholdKv
+>
+class SampleSortInPlaceMultithreadedParent : public SortSequential
+{
+    static_assert(
+        ((numSplittersKo + 1) & numSplittersKo) == 0 && ((numSplittersKv + 1) & numSplittersKv) == 0,
+        "Number of buckets in in-place sample sort has to be power of 2."
+    );
+    static_assert(
+        smallSortThresholdKo >= (numSplittersKo + 1) * oversamplingFactorKo &&
+        smallSortThresholdKv >= (numSplittersKv + 1) * oversamplingFactorKv,
+        "Small sort threshold has to be greater or equal than number of samples."
+    );
+
+protected:
+    std::string _sortName = "Sample sort in-place multithreaded";
+
+    // Memory of every thread
+    thread_storage_t *_threadStorage = NULL;
+    // Number of threads, for which thread storage is allocated
+    uint_t _numThreads = 0;
+
+    /*
+    Allocates memory for every thread. Memory doesn't depend on array length.
+    */
+    void threadStorageAllocate(uint_t numThreads)
+    {
+        uint_t maxNumSplitters = max(numSplittersKo, numSplittersKv);
+        uint_t maxNumBuckets = 2 * maxNumSplitters + 1;
+        uint_t maxBlockSize = max(blockSizeKo, blockSizeKv);
+        uint_t maxNumSamples = max(
+            (numSplittersKo + 1) * oversamplingFactorKo, (numSplittersKv + 1) * oversamplingFactorKv
+        );
+        uint_t maxSmallSortThreshold = max(smallSortThresholdKo, smallSortThresholdKv);
+        auto seed = std::chrono::high_resolution_clock::now().time_since_epoch().count();
+
+        _threadStorage = trackedNew<thread_storage_t>(numThreads);
+        _numThreads = numThreads;
+
+        for (uint_t i = 0; i < numThreads; i++)
+        {
+            thread_storage_t *storage = &_threadStorage[i];
+
+            storage->keysBuffer = (data_t*)trackedMalloc(maxNumBuckets * maxBlockSize * sizeof(*storage->keysBuffer));
+            checkMallocError(storage->keysBuffer);
+            storage->valuesBuffer = (data_t*)trackedMalloc(
+                maxNumBuckets * maxBlockSize * sizeof(*storage->valuesBuffer)
+            );
+            checkMallocError(storage->valuesBuffer);
+            storage->bufferCounts = (uint_t*)trackedMalloc(maxNumBuckets * sizeof(*storage->bufferCounts));
+            checkMallocError(storage->bufferCounts);
+            storage->fullBlocks = (uint_t*)trackedMalloc(maxNumBuckets * sizeof(*storage->fullBlocks));
+            checkMallocError(storage->fullBlocks);
+
+            storage->keysSwap = (data_t*)trackedMalloc(2 * maxBlockSize * sizeof(*storage->keysSwap));
+            checkMallocError(storage->keysSwap);
+            storage->valuesSwap = (data_t*)trackedMalloc(2 * maxBlockSize * sizeof(*storage->valuesSwap));
+            checkMallocError(storage->valuesSwap);
+            storage->smallSortPairs = (key_value_t*)trackedMalloc(
+                maxSmallSortThreshold * sizeof(*storage->smallSortPairs)
+            );
+            checkMallocError(storage->smallSortPairs);
+            storage->generator.seed((uint_t)(seed + i));
+
+            storage->samples = (data_t*)trackedMalloc(maxNumSamples * sizeof(*storage->samples));
+            checkMallocError(storage->samples);
+            storage->splitters = (data_t*)trackedMalloc(maxNumSplitters * sizeof(*storage->splitters));
+            checkMallocError(storage->splitters);
+            storage->splitterTree = (data_t*)trackedMalloc((maxNumSplitters + 1) * sizeof(*storage->splitterTree));
+            checkMallocError(storage->splitterTree);
+            storage->bucketPointers = trackedNew<bucket_ptr_t>(maxNumBuckets);
+
+            storage->keysOverflow = (data_t*)trackedMalloc(
+                maxNumBuckets * maxBlockSize * sizeof(*storage->keysOverflow)
+            );
+            checkMallocError(storage->keysOverflow);
+            storage->valuesOverflow = (data_t*)trackedMalloc(
+                maxNumBuckets * maxBlockSize * sizeof(*storage->valuesOverflow)
+            );
+            checkMallocError(storage->valuesOverflow);
+            storage->overflowCounts = (uint_t*)trackedMalloc(maxNumBuckets * sizeof(*storage->overflowCounts));
+            checkMallocError(storage->overflowCounts);
+            storage->keysOverflowBlock = (data_t*)trackedMalloc(maxBlockSize * sizeof(*storage->keysOverflowBlock));
+            checkMallocError(storage->keysOverflowBlock);
+            storage->valuesOverflowBlock = (data_t*)trackedMalloc(maxBlockSize * sizeof(*storage->valuesOverflowBlock));
+            checkMallocError(storage->valuesOverflowBlock);
+        }
+    }
+
+    /*
+    Destroys memory of every thread.
+    */
+    void threadStorageDestroy()
+    {
+        if (_threadStorage == NULL)
+        {
+            return;
+        }
+
+        for (uint_t i = 0; i < _numThreads; i++)
+        {
+            thread_storage_t *storage = &_threadStorage[i];
+
+            trackedFree(storage->keysBuffer);
+            trackedFree(storage->valuesBuffer);
+            trackedFree(storage->bufferCounts);
+            trackedFree(storage->fullBlocks);
+            trackedFree(storage->keysSwap);
+            trackedFree(storage->valuesSwap);
+            trackedFree(storage->smallSortPairs);
+            trackedFree(storage->samples);
+            trackedFree(storage->splitters);
+            trackedFree(storage->splitterTree);
+            trackedDelete(storage->bucketPointers);
+            trackedFree(storage->keysOverflow);
+            trackedFree(storage->valuesOverflow);
+            trackedFree(storage->overflowCounts);
+            trackedFree(storage->keysOverflowBlock);
+            trackedFree(storage->valuesOverflowBlock);
+        }
+
+        trackedDelete(_threadStorage);
+        _threadStorage = NULL;
+        _numThreads = 0;
+    }
+
+    /*
+    Method for allocating memory needed both for key only and key-value sort.
+    */
+    virtual void memoryAllocate(data_t *h_keys, data_t *h_values, uint_t arrayLength)
+    {
+        SortSequential::memoryAllocate(h_keys, h_values, arrayLength);
+
+        threadStorageDestroy();
+        threadStorageAllocate(getNumThreads());
+    }
+
+    /*
+    If number of threads changed since memory allocation, thread storage is reallocated.
+    */
+    virtual void memoryCopyBeforeSort(data_t *h_keys, data_t *h_values, uint_t arrayLength)
+    {
+        SortSequential::memoryCopyBeforeSort(h_keys, h_values, arrayLength);
+
+        if (_numThreads != getNumThreads())
+        {
+            threadStorageDestroy();
+            threadStorageAllocate(getNumThreads());
+        }
+    }
+
+    /*
+    Sorts small arrays. Key-value pairs are sorted in thread's buffer of pairs.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly>
+    void smallSort(data_t *h_keys, data_t *h_values, thread_storage_t *storage, uint_t arrayLength)
+    {
+        if (sortingKeyOnly)
+        {
+            if (sortOrder == ORDER_ASC)
+            {
+                std::sort(h_keys, h_keys + arrayLength);
+            }
+            else
+            {
+                std::sort(h_keys, h_keys + arrayLength, std::greater<data_t>());
+            }
+            return;
+        }
+
+        key_value_t *pairs = storage->smallSortPairs;
+        for (uint_t i = 0; i < arrayLength; i++)
+        {
+            pairs[i].key = h_keys[i];
+            pairs[i].value = h_values[i];
+        }
+
+        std::sort(pairs, pairs + arrayLength, [](const key_value_t &pair1, const key_value_t &pair2) {
+            return sortOrder == ORDER_ASC ? pair1.key < pair2.key : pair1.key > pair2.key;
+        });
+
+        for (uint_t i = 0; i < arrayLength; i++)
+        {
+            h_keys[i] = pairs[i].key;
+            h_values[i] = pairs[i].value;
+        }
+    }
+
+    /*
+    Collects samples, sorts them and from them generates splitters and implicit binary search tree of splitters.
+    Root of the tree is located at index 1 and children of node "j" are located at indexes "2 * j" and "2 * j + 1".
+    */
+    template <order_t sortOrder, uint_t oversamplingFactor>
+    void collectSplitters(data_t *h_keys, thread_storage_t *storage, uint_t arrayLength, uint_t numTreeBuckets)
+    {
+        std::uniform_int_distribution<uint_t> distribution(0, arrayLength - 1);
+        uint_t numSamples = numTreeBuckets * oversamplingFactor;
+
+        for (uint_t i = 0; i < numSamples; i++)
+        {
+            storage->samples[i] = h_keys[distribution(storage->generator)];
+        }
+
+        stdVectorSort<data_t>(storage->samples, numSamples, sortOrder);
+
+        for (uint_t i = 0; i < numTreeBuckets - 1; i++)
+        {
+            storage->splitters[i] = storage->samples[i * oversamplingFactor + (oversamplingFactor / 2)];
+        }
+
+        for (uint_t levelSize = 1; levelSize < numTreeBuckets; levelSize <<= 1)
+        {
+            uint_t stride = numTreeBuckets / levelSize;
+
+            for (uint_t node = 0; node < levelSize; node++)
+            {
+                storage->splitterTree[levelSize + node] = storage->splitters[node * stride + stride / 2 - 1];
+            }
+        }
+    }
+
+    /*
+    Returns the bucket of element. Element belongs to tree bucket "i", if "splitter[i - 1] < element <= splitter[i]"
+    (for ascending order). Every tree bucket "i" is followed by equality bucket, which contains elements equal to
+    "splitter[i]". Equality buckets don't have to be sorted.
+    */
+    template <order_t sortOrder>
+    inline uint_t classifyElement(data_t key, thread_storage_t *shared, uint_t numTreeBuckets)
+    {
+        uint_t node = 1;
+
+        for (uint_t levelSize = 1; levelSize < numTreeBuckets; levelSize <<= 1)
+        {
+            data_t splitter = shared->splitterTree[node];
+            node = 2 * node + (sortOrder == ORDER_ASC ? key > splitter : key < splitter);
+        }
+
+        uint_t treeBucket = node - numTreeBuckets;
+        bool isEqual = treeBucket < numTreeBuckets - 1 && key == shared->splitters[treeBucket];
+
+        return 2 * treeBucket + isEqual;
+    }
+
+    /*
+    Classifies the stripe of array into buffer blocks of thread. When buffer block gets full, it is written back to
+    the beginning of stripe. This is always possible, because more elements were already read from stripe, than
+    written back.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly, uint_t blockSize>
+    void classifyStripe(
+        data_t *h_keys, data_t *h_values, thread_storage_t *storage, thread_storage_t *shared, uint_t numTreeBuckets
+    )
+    {
+        const uint_t unroll = CLASSIFICATION_UNROLL_IN_PLACE;
+        uint_t numBuckets = 2 * numTreeBuckets - 1;
+        uint_t writeIndex = storage->stripeStart;
+        uint_t index = storage->stripeStart;
+
+        for (uint_t bucket = 0; bucket < numBuckets; bucket++)
+        {
+            storage->bufferCounts[bucket] = 0;
+            storage->fullBlocks[bucket] = 0;
+        }
+
+        while (index < storage->stripeEnd)
+        {
+            uint_t buckets[unroll];
+            uint_t groupSize = min(unroll, storage->stripeEnd - index);
+
+            // Classifications of elements are independent from each other, which enables instruction-level
+            // parallelism.
+            for (uint_t u = 0; u < groupSize; u++)
+            {
+                buckets[u] = classifyElement<sortOrder>(h_keys[index + u], shared, numTreeBuckets);
+            }
+
+            for (uint_t u = 0; u < groupSize; u++, index++)
+            {
+                uint_t bucket = buckets[u];
+                uint_t bufferIndex = bucket * blockSize + storage->bufferCounts[bucket]++;
+
+                storage->keysBuffer[bufferIndex] = h_keys[index];
+                if (!sortingKeyOnly)
+                {
+                    storage->valuesBuffer[bufferIndex] = h_values[index];
+                }
+
+                if (storage->bufferCounts[bucket] < blockSize)
+                {
+                    continue;
+                }
+
+                // Buffer block is full and it is written back to stripe
+                data_t *keysBlock = storage->keysBuffer + bucket * blockSize;
+                std::copy(keysBlock, keysBlock + blockSize, h_keys + writeIndex);
+                if (!sortingKeyOnly)
+                {
+                    data_t *valuesBlock = storage->valuesBuffer + bucket * blockSize;
+                    std::copy(valuesBlock, valuesBlock + blockSize, h_values + writeIndex);
+                }
+
+                writeIndex += blockSize;
+                storage->bufferCounts[bucket] = 0;
+                storage->fullBlocks[bucket]++;
+            }
+        }
+
+        storage->stripeWriteEnd = writeIndex;
+    }
+
+    /*
+    Returns true, if block on provided offset contains classified elements (hasn't been emptied during
+    classification).
+    */
+    bool isBlockFull(thread_storage_t *storage, uint_t numThreads, uint_t blockOffset)
+    {
+        for (uint_t t = 0; t < numThreads; t++)
+        {
+            if (blockOffset >= storage[t].stripeStart && blockOffset < storage[t].stripeEnd)
+            {
+                return blockOffset < storage[t].stripeWriteEnd;
+            }
+        }
+
+        return false;
+    }
+
+    /*
+    Moves full blocks inside bucket to the beginning of bucket, so bucket consists of full blocks followed by
+    empty blocks. Returns the number of full blocks in bucket.
+    */
+    template <bool sortingKeyOnly, uint_t blockSize>
+    uint_t moveEmptyBlocks(
+        data_t *h_keys, data_t *h_values, thread_storage_t *storage, uint_t numThreads, uint_t bucketStart,
+        uint_t bucketEnd
+    )
+    {
+        uint_t numFullBlocks = 0;
+
+        for (uint_t t = 0; t < numThreads; t++)
+        {
+            uint_t start = max(storage[t].stripeStart, bucketStart);
+            uint_t end = min(storage[t].stripeWriteEnd, bucketEnd);
+
+            if (start < end)
+            {
+                numFullBlocks += (end - start) / blockSize;
+            }
+        }
+
+        uint_t fullEnd = bucketStart + numFullBlocks * blockSize;
+        uint_t emptyIndex = bucketStart;
+        uint_t fullIndex = fullEnd;
+
+        while (true)
+        {
+            while (emptyIndex < fullEnd && isBlockFull(storage, numThreads, emptyIndex))
+            {
+                emptyIndex += blockSize;
+            }
+            while (fullIndex < bucketEnd && !isBlockFull(storage, numThreads, fullIndex))
+            {
+                fullIndex += blockSize;
+            }
+
+            if (emptyIndex >= fullEnd || fullIndex >= bucketEnd)
+            {
+                break;
+            }
+
+            std::copy(h_keys + fullIndex, h_keys + fullIndex + blockSize, h_keys + emptyIndex);
+            if (!sortingKeyOnly)
+            {
+                std::copy(h_values + fullIndex, h_values + fullIndex + blockSize, h_values + emptyIndex);
+            }
+
+            emptyIndex += blockSize;
+            fullIndex += blockSize;
+        }
+
+        return numFullBlocks;
+    }
+
+    /*
+    Reads block from array. Block, which exceeds the end of array is read from overflow block.
+    */
+    template <bool sortingKeyOnly, uint_t blockSize>
+    void readBlock(
+        data_t *h_keys, data_t *h_values, data_t *keysBlock, data_t *valuesBlock, thread_storage_t *shared,
+        uint_t blockOffset, uint_t arrayLength
+    )
+    {
+        data_t *keysSource = blockOffset + blockSize > arrayLength ?
+            shared->keysOverflowBlock : h_keys + blockOffset;
+        std::copy(keysSource, keysSource + blockSize, keysBlock);
+
+        if (!sortingKeyOnly)
+        {
+            data_t *valuesSource = blockOffset + blockSize > arrayLength ?
+                shared->valuesOverflowBlock : h_values + blockOffset;
+            std::copy(valuesSource, valuesSource + blockSize, valuesBlock);
+        }
+    }
+
+    /*
+    Writes block to array. Block, which would exceed the end of array is written to overflow block.
+    */
+    template <bool sortingKeyOnly, uint_t blockSize>
+    void writeBlock(
+        data_t *h_keys, data_t *h_values, data_t *keysBlock, data_t *valuesBlock, thread_storage_t *shared,
+        uint_t blockOffset, uint_t arrayLength
+    )
+    {
+        data_t *keysDestination = blockOffset + blockSize > arrayLength ?
+            shared->keysOverflowBlock : h_keys + blockOffset;
+        std::copy(keysBlock, keysBlock + blockSize, keysDestination);
+
+        if (!sortingKeyOnly)
+        {
+            data_t *valuesDestination = blockOffset + blockSize > arrayLength ?
+                shared->valuesOverflowBlock : h_values + blockOffset;
+            std::copy(valuesBlock, valuesBlock + blockSize, valuesDestination);
+        }
+    }
+
+    /*
+    Permutes blocks into their buckets. Thread starts with it's primary bucket and takes unprocessed blocks from
+    it. Every block taken is written to the next free position of it's bucket. If there is an unprocessed block on
+    that position, it is swapped with the current block and the procedure continues with the swapped block.
+    */
+    template <order_t sortOrder, bool sortingKeyOnly, uint_t blockSize>
+    void permuteBlocks(
+        data_t *h_keys, data_t *h_values, thread_storage_t *storage, thread_storage_t *shared, uint_t threadIndex,
+        uint_t numThreads, uint_t numTreeBuckets, uint_t arrayLength
+    )
+    {
+        uint_t numBuckets = 2 * numTreeBuckets - 1;
+        uint_t primaryBucket = threadIndex * numBuckets / numThreads;
+        data_t *keysBlock = storage->keysSwap, *keysBlockSwap = storage->keysSwap + blockSize;
+        data_t *valuesBlock = storage->valuesSwap, *valuesBlockSwap = storage->valuesSwap + blockSize;
+
+        for (uint_t i = 0; i < numBuckets; i++)
+        {
+            bucket_ptr_t *readBucket = &shared->bucketPointers[(primaryBucket + i) % numBuckets];
+
+            while (true)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(readBucket->mutex);
+                    if (readBucket->write >= readBucket->read)
+                    {
+                        break;
+                    }
+
+                    readBucket->read -= blockSize;
+                    readBlock<sortingKeyOnly, blockSize>(
+                        h_keys, h_values, keysBlock, valuesBlock, shared, readBucket->read, arrayLength
+                    );
+                }
+
+                // Swaps blocks until block is written to empty position
+                while (true)
+                {
+                    uint_t bucket = classifyElement<sortOrder>(keysBlock[0], shared, numTreeBuckets);
+                    bucket_ptr_t *writeBucket = &shared->bucketPointers[bucket];
+                    std::lock_guard<std::mutex> lock(writeBucket->mutex);
+
+                    uint_t writeIndex = writeBucket->write;
+                    writeBucket->write += blockSize;
+
+                    if (writeIndex >= writeBucket->read)
+                    {
+                        writeBlock<sortingKeyOnly, blockSize>(
+                            h_keys, h_values, keysBlock, valuesBlock, shared, writeIndex, arrayLength
+                        );
+                        break;
+                    }
+
+                    readBlock<sortingKeyOnly, blockSize>(
+                        h_keys, h_values, keysBlockSwap, valuesBlockSwap, shared, writeIndex, arrayLength
+                    );
+                    writeBlock<sortingKeyOnly, blockSize>(
+                        h_keys, h_values, keysBlock, valuesBlock, shared, writeIndex, arrayLength
+                    );
+
+                    std::swap(keysBlock, keysBlockSwap);
+                    std::swap(valuesBlock, valuesBlockSwap);
+                }
+            }
+        }
+    }
+
+    /*
+    Last block of bucket can overflow into the beginning of the next bucket. Overflowing elements are saved, because
+    the beginning of next bucket is overwritten during cleanup.
+    */
+    template <bool sortingKeyOnly, uint_t blockSize>
+    void saveBucketOverflow(
+        data_t *h_keys, data_t *h_values, thread_storage_t *shared, uint_t *bucketOffsets, uint_t *fullBlocks,
+        uint_t bucket, uint_t arrayLength
+    )
+    {
+        uint_t bucketEnd = bucketOffsets[bucket + 1];
+        uint_t blocksStart = (bucketOffsets[bucket] + blockSize - 1) / blockSize * blockSize;
+        uint_t blocksEnd = blocksStart + fullBlocks[bucket] * blockSize;
+
+        shared->overflowCounts[bucket] = 0;
+        if (fullBlocks[bucket] == 0 || blocksEnd <= bucketEnd)
+        {
+            return;
+        }
+
+        uint_t lastBlockStart = blocksEnd - blockSize;
+        uint_t numElementsInBucket = bucketEnd - lastBlockStart;
+        data_t *keysOverflow = shared->keysOverflow + bucket * blockSize;
+        data_t *valuesOverflow = shared->valuesOverflow + bucket * blockSize;
+
+        if (blocksEnd > arrayLength)
+        {
+            // Last block was written to overflow block, because it exceeds the end of array
+            data_t *keysBlock = shared->keysOverflowBlock;
+            std::copy(keysBlock, keysBlock + numElementsInBucket, h_keys + lastBlockStart);
+            std::copy(keysBlock + numElementsInBucket, keysBlock + blockSize, keysOverflow);
+
+            if (!sortingKeyOnly)
+            {
+                data_t *valuesBlock = shared->valuesOverflowBlock;
+                std::copy(valuesBlock, valuesBlock + numElementsInBucket, h_values + lastBlockStart);
+                std::copy(valuesBlock + numElementsInBucket, valuesBlock + blockSize, valuesOverflow);
+            }
+        }
+        else
+        {
+            std::copy(h_keys + bucketEnd, h_keys + blocksEnd, keysOverflow);
+            if (!sortingKeyOnly)
+            {
+                std::copy(h_values + bucketEnd, h_values + blocksEnd, valuesOverflow);
+            }
+        }
+
+        shared->overflowCounts[bucket] = blocksEnd - bucketEnd;
+    }
+
+    /*
+    Fills the parts of bucket, which aren't covered by full blocks (the beginning of bucket before the first block
+    and the end of bucket after the last block), with overflowing elements and elements in buffer blocks.
+    */
+    template <bool sortingKeyOnly, uint_t blockSize>
+    void cleanupBucket(
+        data_t *h_keys, data_t *h_values, thread_storage_t *storage, thread_storage_t *shared, uint_t numThreads,
+        uint_t *bucketOffsets, uint_t *fullBlocks, uint_t bucket
+    )
+    {
+        uint_t bucketStart = bucketOffsets[bucket];
+        uint_t bucketEnd = bucketOffsets[bucket + 1];
+        uint_t blocksStart = (bucketStart + blockSize - 1) / blockSize * blockSize;
+        uint_t blocksEnd = blocksStart + fullBlocks[bucket] * blockSize;
+
+        // Gap at the beginning and gap at the end of bucket
+        uint_t headEnd = fullBlocks[bucket] == 0 ? bucketEnd : blocksStart;
+        uint_t tailStart = fullBlocks[bucket] == 0 ? bucketEnd : min(blocksEnd, bucketEnd);
+        uint_t index = bucketStart;
+
+        auto writeElements = [&](data_t *keysSource, data_t *valuesSource, uint_t numElements)
+        {
+            for (uint_t i = 0; i < numElements; i++, index++)
+            {
+                if (index == headEnd)
+                {
+                    index = tailStart;
+                }
+
+                h_keys[index] = keysSource[i];
+                if (!sortingKeyOnly)
+                {
+                    h_values[index] = valuesSource[i];
+                }
+            }
+        };
+
+        writeElements(
+            shared->keysOverflow + bucket * blockSize, shared->valuesOverflow + bucket * blockSize,
+            shared->overflowCounts[bucket]
+        );
+
+        for (uint_t t = 0; t < numThreads; t++)
+        {
+            writeElements(
+                storage[t].keysBuffer + bucket * blockSize, storage[t].valuesBuffer + bucket * blockSize,
+                storage[t].bufferCounts[bucket]
+            );
+        }
+    }
+
+    /*
+    Partitions array into buckets with provided number of threads and outputs bucket offsets (start of every
+    bucket and end of last bucket). Returns the number of tree buckets.
+    */
+    template <
+        order_t sortOrder, bool sortingKeyOnly, uint_t numSplitters, uint_t blockSize, uint_t oversamplingFactor,
+        uint_t smallSortThreshold
+    >
+    uint_t partitionArray(
+        data_t *h_keys, data_t *h_values, thread_storage_t *storage, uint_t *bucketOffsets, uint_t numThreads,
+        uint_t arrayLength
+    )
+    {
+        thread_storage_t *shared = &storage[0];
+        uint_t numTreeBuckets = min(numSplitters + 1, nextPowerOf2((arrayLength - 1) / smallSortThreshold + 1));
+        numTreeBuckets = max(numTreeBuckets, 2);
+        uint_t numBuckets = 2 * numTreeBuckets - 1;
+        uint_t fullBlocks[2 * numSplitters + 1];
+
+        {
+            TRACE_SCOPE_SIZED("ips4o sampling", "length", arrayLength, arrayLength);
+            collectSplitters<sortOrder, oversamplingFactor>(h_keys, shared, arrayLength, numTreeBuckets);
+        }
+
+        // Every thread classifies one stripe of array. Stripes are aligned to block size.
+        for (uint_t t = 0; t < numThreads; t++)
+        {
+            storage[t].stripeStart = (uint_t)((uint64_t)arrayLength * t / numThreads / blockSize * blockSize);
+            storage[t].stripeEnd = (uint_t)((uint64_t)arrayLength * (t + 1) / numThreads / blockSize * blockSize);
+        }
+        storage[numThreads - 1].stripeEnd = arrayLength;
+
+        parallelFor(numThreads, [&](uint_t threadIndex) {
+            TRACE_SCOPE_SIZED("ips4o classification", "length", arrayLength, arrayLength);
+            classifyStripe<sortOrder, sortingKeyOnly, blockSize>(
+                h_keys, h_values, &storage[threadIndex], shared, numTreeBuckets
+            );
+        });
+
+        // Computes bucket offsets and number of full blocks in every bucket
+        bucketOffsets[0] = 0;
+        for (uint_t bucket = 0; bucket < numBuckets; bucket++)
+        {
+            uint_t bucketSize = 0;
+            fullBlocks[bucket] = 0;
+
+            for (uint_t t = 0; t < numThreads; t++)
+            {
+                bucketSize += storage[t].fullBlocks[bucket] * blockSize + storage[t].bufferCounts[bucket];
+                fullBlocks[bucket] += storage[t].fullBlocks[bucket];
+            }
+
+            bucketOffsets[bucket + 1] = bucketOffsets[bucket] + bucketSize;
+        }
+
+        // Inside every bucket (aligned to block size) moves full blocks before empty blocks
+        parallelFor(numThreads, [&](uint_t threadIndex) {
+            TRACE_SCOPE_SIZED("ips4o empty block movement", "length", arrayLength, arrayLength);
+
+            for (uint_t bucket = threadIndex; bucket < numBuckets; bucket += numThreads)
+            {
+                uint_t bucketStart = (bucketOffsets[bucket] + blockSize - 1) / blockSize * blockSize;
+                uint_t bucketEnd = (bucketOffsets[bucket + 1] + blockSize - 1) / blockSize * blockSize;
+                uint_t numFullBlocks = moveEmptyBlocks<sortingKeyOnly, blockSize>(
+                    h_keys, h_values, storage, numThreads, bucketStart, bucketEnd
+                );
+
+                shared->bucketPointers[bucket].write = bucketStart;
+                shared->bucketPointers[bucket].read = bucketStart + numFullBlocks * blockSize;
+            }
+        });
+
+        parallelFor(numThreads, [&](uint_t threadIndex) {
+            TRACE_SCOPE_SIZED("ips4o block permutation", "length", arrayLength, arrayLength);
+            permuteBlocks<sortOrder, sortingKeyOnly, blockSize>(
+                h_keys, h_values, &storage[threadIndex], shared, threadIndex, numThreads, numTreeBuckets,
+                arrayLength
+            );
+        });
+
+        // Overflows have to be saved for all buckets, before any bucket is cleaned up
+        parallelFor(numThreads, [&](uint_t threadIndex) {
+            TRACE_SCOPE_SIZED("ips4o overflow", "length", arrayLength, arrayLength);
+
+            for (uint_t bucket = threadIndex; bucket < numBuckets; bucket += numThreads)
+            {
+                saveBucketOverflow<sortingKeyOnly, blockSize>(
+                    h_keys, h_values, shared, bucketOffsets, fullBlocks, bucket, arrayLength
+                );
+            }
+        });
+
+        parallelFor(numThreads, [&](uint_t threadIndex) {
+            TRACE_SCOPE_SIZED("ips4o cleanup", "length", arrayLength, arrayLength);
+
+            for (uint_t bucket = threadIndex; bucket < numBuckets; bucket += numThreads)
+            {
+                cleanupBucket<sortingKeyOnly, blockSize>(
+                    h_keys, h_values, storage, shared, numThreads, bucketOffsets, fullBlocks, bucket
+                );
+            }
+        });
+
+        return numTreeBuckets;
+    }
+
+    /*
+    Sorts array with in-place sample sort. Sorting is performed with provided number of threads, where
+    "storage[i]" is the memory of i-th thread.
+    */
+    template <
+        order_t sortOrder, bool sortingKeyOnly, uint_t numSplitters, uint_t blockSize, uint_t oversamplingFactor,
+        uint_t smallSortThreshold
+    >
+    void sampleSortInPlace(
+        data_t *h_keys, data_t *h_values, thread_storage_t *storage, uint_t numThreads, uint_t arrayLength
+    )
+    {
+        if (arrayLength <= smallSortThreshold)
+        {
+            smallSort<sortOrder, sortingKeyOnly>(h_keys, h_values, storage, arrayLength);
+            return;
+        }
+
+        uint_t bucketOffsets[2 * numSplitters + 2];
+        uint_t numTreeBuckets = partitionArray<
+            sortOrder, sortingKeyOnly, numSplitters, blockSize, oversamplingFactor, smallSortThreshold
+        >(h_keys, h_values, storage, bucketOffsets, numThreads, arrayLength);
+
+        // Recursively sorts buckets. Equality buckets (odd indexes) are already sorted.
+        std::vector<uint_t> sequentialBuckets;
+        for (uint_t bucket = 0; bucket < 2 * numTreeBuckets - 1; bucket += 2)
+        {
+            uint_t bucketStart = bucketOffsets[bucket];
+            uint_t bucketSize = bucketOffsets[bucket + 1] - bucketStart;
+
+            if (bucketSize <= 1)
+            {
+                continue;
+            }
+
+            // Big buckets are sorted with all threads, small buckets are distributed among threads
+            if (numThreads > 1 && bucketSize > arrayLength / (numThreads * PARALLEL_BUCKET_FACTOR_IN_PLACE))
+            {
+                sampleSortInPlace<
+                    sortOrder, sortingKeyOnly, numSplitters, blockSize, oversamplingFactor, smallSortThreshold
+                >(
+                    h_keys + bucketStart, sortingKeyOnly ? NULL : h_values + bucketStart, storage, numThreads,
+                    bucketSize
+                );
+            }
+            else
+            {
+                sequentialBuckets.push_back(bucket);
+            }
+        }
+
+        std::atomic<uint_t> bucketCounter(0);
+        parallelFor(numThreads, [&](uint_t threadIndex) {
+            TRACE_SCOPE_SIZED("ips4o small buckets", "length", arrayLength, arrayLength);
+            uint_t i;
+
+            while ((i = bucketCounter++) < sequentialBuckets.size())
+            {
+                uint_t bucketStart = bucketOffsets[sequentialBuckets[i]];
+                uint_t bucketSize = bucketOffsets[sequentialBuckets[i] + 1] - bucketStart;
+
+                sampleSortInPlace<
+                    sortOrder, sortingKeyOnly, numSplitters, blockSize, oversamplingFactor, smallSortThreshold
+                >(
+                    h_keys + bucketStart, sortingKeyOnly ? NULL : h_values + bucketStart, &storage[threadIndex],
+                    1, bucketSize
+                );
+            }
+        });
+    }
+
+    /*
+    Wrapper for in-place sample sort method.
+    The code runs faster if arguments are passed to method. If members are accessed directly, code runs slower.
+    */
+    void sortKeyOnly()
+    {
+        if (_sortOrder == ORDER_ASC)
+        {
+            sampleSortInPlace<
+                ORDER_ASC, true, numSplittersKo, blockSizeKo, oversamplingFactorKo, smallSortThresholdKo
+            >(_h_keys, NULL, _threadStorage, _numThreads, _arrayLength);
+        }
+        else
+        {
+            sampleSortInPlace<
+                ORDER_DESC, true, numSplittersKo, blockSizeKo, oversamplingFactorKo, smallSortThresholdKo
+            >(_h_keys, NULL, _threadStorage, _numThreads, _arrayLength);
+        }
+    }
+
+    /*
+    Wrapper for in-place sample sort method.
+    The code runs faster if arguments are passed to method. If members are accessed directly, code runs slower.
+    */
+    void sortKeyValue()
+    {
+        if (_sortOrder == ORDER_ASC)
+        {
+            sampleSortInPlace<
+                ORDER_ASC, false, numSplittersKv, blockSizeKv, oversamplingFactorKv, smallSortThresholdKv
+            >(_h_keys, _h_values, _threadStorage, _numThreads, _arrayLength);
+        }
+        else
+        {
+            sampleSortInPlace<
+                ORDER_DESC, false, numSplittersKv, blockSizeKv, oversamplingFactorKv, smallSortThresholdKv
+            >(_h_keys, _h_values, _threadStorage, _numThreads, _arrayLength);
+        }
+    }
+
+public:
+    std::string getSortName()
+    {
+        return this->_sortName;
+    }
+
+    /*
+    Every distribution level reads and writes keys and values twice (classification into buffer blocks and block
+    permutation). Distribution levels are executed from main memory only while their buckets don't fit into last
+    level cache. Buckets on the last level are sorted in cache.
+    */
+    double getBytesMoved()
+    {
+        bool sortingKeyOnly = _h_values == NULL;
+        uint_t numBuckets = (sortingKeyOnly ? numSplittersKo : numSplittersKv) + 1;
+        uint_t smallSortThreshold = sortingKeyOnly ? smallSortThresholdKo : smallSortThresholdKv;
+        double bucketLength;
+
+        double numLevels = getNumDistributionLevels(_arrayLength, numBuckets, smallSortThreshold, &bucketLength);
+        double numMemoryLevels = getNumMemoryLevels(numLevels, numBuckets, getElementSize());
+
+        return getBytesOfPasses(4 * numMemoryLevels, 4 * numMemoryLevels) +
+            getBytesOfCacheLevels(numLevels + 1, numMemoryLevels);
+    }
+
+    /*
+    Method for destroying memory needed for sort. For sort testing purposes this method is public.
+    */
+    void memoryDestroy()
+    {
+        if (_arrayLength == 0)
+        {
+            return;
+        }
+
+        SortSequential::memoryDestroy();
+        threadStorageDestroy();
+    }
+};
+
+/*
+Class for multithreaded in-place sample sort.
+*/
+class SampleSortInPlaceMultithreaded : public SampleSortInPlaceMultithreadedParent<
+    NUM_SPLITTERS_IN_PLACE_KO, NUM_SPLITTERS_IN_PLACE_KV,
+    BLOCK_SIZE_IN_PLACE_KO, BLOCK_SIZE_IN_PLACE_KV,
+    OVERSAMPLING_FACTOR_IN_PLACE_KO, OVERSAMPLING_FACTOR_IN_PLACE_KV,
+    SMALL_SORT_THRESHOLD_IN_PLACE_KO, SMALL_SORT_THRESHOLD_IN_PLACE_KV
+>
+{};
+
+#endif
@@ -0,0 +1,3 @@
+/*
+Visual studio doesn't generate a .lib file, if project doesn't contain at least one .cpp file.
+*/
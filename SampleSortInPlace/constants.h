@@ -0,0 +1,61 @@
+#ifndef CONSTANTS_SAMPLE_SORT_IN_PLACE_H
+#define CONSTANTS_SAMPLE_SORT_IN_PLACE_H
+
+#include "../Utils/data_types_common.h"
+
+
+/*
+_KO: Key-only
+_KV: Key-value
+*/
+
+/* ------------ MULTITHREADED ALGORITHM PARAMETERS ------------ */
+
+// Maximum number of splitters used for buckets. From "N" splitters "N + 1" buckets are created and additional
+// "N" equality buckets (for elements equal to splitters). "N + 1" has to be power of 2.
+#if DATA_TYPE_BITS == 32
+#define NUM_SPLITTERS_IN_PLACE_KO 127
+#define NUM_SPLITTERS_IN_PLACE_KV 63
+#else
+#define NUM_SPLITTERS_IN_PLACE_KO 63
+#define NUM_SPLITTERS_IN_PLACE_KV 63
+#endif
+
+// Number of elements in block. Elements are distributed into buckets in blocks. Every thread holds one buffer
+// block for every bucket.
+#if DATA_TYPE_BITS == 32
+#define BLOCK_SIZE_IN_PLACE_KO 256
+#define BLOCK_SIZE_IN_PLACE_KV 256
+#else
+#define BLOCK_SIZE_IN_PLACE_KO 128
+#define BLOCK_SIZE_IN_PLACE_KV 128
+#endif
+
+// How many elements are classified at the same time (classifications of different elements are independent from
+// each other, which enables instruction-level parallelism).
+#define CLASSIFICATION_UNROLL_IN_PLACE 8
+
+// How many extra samples are taken for every splitter.
+#if DATA_TYPE_BITS == 32
+#define OVERSAMPLING_FACTOR_IN_PLACE_KO 8
+#define OVERSAMPLING_FACTOR_IN_PLACE_KV 8
+#else
+#define OVERSAMPLING_FACTOR_IN_PLACE_KO 8
+#define OVERSAMPLING_FACTOR_IN_PLACE_KV 8
+#endif
+
+// Threshold, when small sort is applied. Has to be greater or equal than
+// "(NUM_SPLITTERS_IN_PLACE + 1) * OVERSAMPLING_FACTOR_IN_PLACE".
+#if DATA_TYPE_BITS == 32
+#define SMALL_SORT_THRESHOLD_IN_PLACE_KO (1 << 12)
+#define SMALL_SORT_THRESHOLD_IN_PLACE_KV (1 << 12)
+#else
+#define SMALL_SORT_THRESHOLD_IN_PLACE_KO (1 << 12)
+#define SMALL_SORT_THRESHOLD_IN_PLACE_KV (1 << 12)
+#endif
+
+// Buckets greater than "arrayLength / (numThreads * PARALLEL_BUCKET_FACTOR)" are sorted with all threads.
+// Smaller buckets are distributed among threads and every thread sorts it's buckets sequentially.
+#define PARALLEL_BUCKET_FACTOR_IN_PLACE 2
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef DATA_TYPES_SAMPLE_SORT_IN_PLACE_H
+#define DATA_TYPES_SAMPLE_SORT_IN_PLACE_H
+
+#include <stdint.h>
+#include <mutex>
+#include <random>
+
+#include "../Utils/data_types_common.h"
+
+
+typedef struct BucketPointers bucket_ptr_t;
+typedef struct KeyValuePair key_value_t;
+typedef struct ThreadStorage thread_storage_t;
+
+
+/*
+Pointers into bucket during block permutation. Blocks in interval [bucketStart, write) are already located in the
+correct bucket, blocks in interval [write, read) still have to be permuted and interval [read, bucketEnd) is empty.
+*/
+struct BucketPointers
+{
+    uint_t write;
+    uint_t read;
+    std::mutex mutex;
+};
+
+/*
+Key-value pair needed for small sort of key-value pairs.
+*/
+struct KeyValuePair
+{
+    data_t key;
+    data_t value;
+};
+
+/*
+Memory owned by one thread. Size of this memory doesn't depend on array length, which is why the sort is in-place.
+
+Thread storage of the thread, which performs the partitioning, is also used for data shared between threads
+(splitters, bucket pointers and bucket overflows).
+*/
+struct ThreadStorage
+{
+    // One buffer block for every bucket, where classified elements are collected until block is full
+    data_t *keysBuffer;
+    data_t *valuesBuffer;
+    // Number of elements in every buffer block
+    uint_t *bufferCounts;
+    // Number of full blocks of every bucket written back to array during classification
+    uint_t *fullBlocks;
+    // Interval of array classified by this thread and end of full blocks, which were written back to array
+    uint_t stripeStart;
+    uint_t stripeEnd;
+    uint_t stripeWriteEnd;
+
+    // Two blocks for swapping blocks during block permutation
+    data_t *keysSwap;
+    data_t *valuesSwap;
+    // Pairs for small sort of key-value pairs
+    key_value_t *smallSortPairs;
+    // Generator used for sampling
+    std::mt19937 generator;
+
+    // Samples, splitters and implicit binary search tree of splitters
+    data_t *samples;
+    data_t *splitters;
+    data_t *splitterTree;
+    // Pointers into buckets used for block permutation
+    bucket_ptr_t *bucketPointers;
+    // Elements of the last block of bucket, which overflow into next bucket
+    data_t *keysOverflow;
+    data_t *valuesOverflow;
+    uint_t *overflowCounts;
+    // Block, which is written behind the end of array during block permutation
+    data_t *keysOverflowBlock;
+    data_t *valuesOverflowBlock;
+};
+
+#endif
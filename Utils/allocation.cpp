@@ -0,0 +1,128 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <cstddef>
+#include <mutex>
+#include <algorithm>
+
+#include "data_types_common.h"
+#include "timer.h"
+#include "cache.h"
+#include "allocation.h"
+
+
+/*
+Header, which precedes every allocated block. Its alignment keeps alignment of memory returned by "malloc".
+*/
+struct alignas(std::max_align_t) AllocationHeader
+{
+    size_t size;
+    // Denotes if block was mapped with "allocateFreshPages" instead of "malloc"
+    bool isFreshPages;
+};
+
+static const size_t ALLOCATION_HEADER_SIZE = sizeof(AllocationHeader);
+
+static allocation_stats_t allocationStatistics = { 0, 0, 0, 0, 0 };
+static std::mutex allocationMutex;
+static bool freshPageAllocation = false;
+
+
+/*
+Allocates memory with "malloc" (or maps fresh pages, if enabled with "setFreshPageAllocation") and adds it to
+allocation statistics. Returns NULL, if memory couldn't be allocated.
+*/
+void* trackedMalloc(size_t size)
+{
+    bool isFreshPages = freshPageAllocation;
+
+    stopwatch_t timer;
+    startStopwatch(&timer);
+    char *block = (char*)(isFreshPages ? allocateFreshPages(size + ALLOCATION_HEADER_SIZE) :
+        malloc(size + ALLOCATION_HEADER_SIZE));
+    double time = endStopwatch(timer);
+
+    if (block == NULL)
+    {
+        return NULL;
+    }
+
+    AllocationHeader *header = (AllocationHeader*)block;
+    header->size = size;
+    header->isFreshPages = isFreshPages;
+
+    std::lock_guard<std::mutex> lock(allocationMutex);
+    allocationStatistics.currentBytes += size;
+    allocationStatistics.peakBytes = (std::max)(allocationStatistics.peakBytes, allocationStatistics.currentBytes);
+    allocationStatistics.numAllocations++;
+    allocationStatistics.allocationTime += time;
+
+    return block + ALLOCATION_HEADER_SIZE;
+}
+
+/*
+Frees memory allocated with "trackedMalloc".
+*/
+void trackedFree(void *memory)
+{
+    if (memory == NULL)
+    {
+        return;
+    }
+
+    AllocationHeader *header = (AllocationHeader*)((char*)memory - ALLOCATION_HEADER_SIZE);
+    size_t size = header->size;
+
+    stopwatch_t timer;
+    startStopwatch(&timer);
+    if (header->isFreshPages)
+    {
+        freeFreshPages(header, size + ALLOCATION_HEADER_SIZE);
+    }
+    else
+    {
+        free(header);
+    }
+    double time = endStopwatch(timer);
+
+    std::lock_guard<std::mutex> lock(allocationMutex);
+    allocationStatistics.currentBytes -= size;
+    allocationStatistics.numFrees++;
+    allocationStatistics.allocationTime += time;
+}
+
+/*
+Returns the size of memory allocated with "trackedMalloc".
+*/
+size_t getTrackedSize(void *memory)
+{
+    return ((AllocationHeader*)((char*)memory - ALLOCATION_HEADER_SIZE))->size;
+}
+
+/*
+If enabled, memory is mapped directly from operating system with "allocateFreshPages", so pages of every
+allocation are touched for the first time by the sort (except the first page, which contains header). Used for
+page-cold tests.
+*/
+void setFreshPageAllocation(bool isEnabled)
+{
+    freshPageAllocation = isEnabled;
+}
+
+/*
+Starts new measurement of allocation statistics. Memory, which is currently allocated, is included in peak.
+*/
+void resetAllocationStatistics()
+{
+    std::lock_guard<std::mutex> lock(allocationMutex);
+    allocationStatistics.peakBytes = allocationStatistics.currentBytes;
+    allocationStatistics.numAllocations = 0;
+    allocationStatistics.numFrees = 0;
+    allocationStatistics.allocationTime = 0;
+}
+
+allocation_stats_t getAllocationStatistics()
+{
+    std::lock_guard<std::mutex> lock(allocationMutex);
+    return allocationStatistics;
+}
@@ -0,0 +1,74 @@
+#ifndef ALLOCATION_H
+#define ALLOCATION_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <new>
+
+#include "data_types_common.h"
+#include "host.h"
+
+
+/*
+Statistics of memory allocated by sorts through "trackedMalloc" and "trackedNew". Peak, number of allocations and
+allocation time are counted from the last call of "resetAllocationStatistics". Allocation time contains only time
+of "malloc" and "free" calls (page faults on first touch of memory aren't included).
+*/
+struct AllocationStatistics
+{
+    // Number of bytes currently allocated
+    uint64_t currentBytes;
+    // Maximum number of bytes, which were allocated at the same time
+    uint64_t peakBytes;
+    uint64_t numAllocations;
+    uint64_t numFrees;
+    // Time of allocations and frees in milliseconds
+    double allocationTime;
+};
+typedef struct AllocationStatistics allocation_stats_t;
+
+void* trackedMalloc(size_t size);
+void trackedFree(void *memory);
+size_t getTrackedSize(void *memory);
+void setFreshPageAllocation(bool isEnabled);
+void resetAllocationStatistics();
+allocation_stats_t getAllocationStatistics();
+
+/*
+Allocates and constructs array of objects, which is tracked the same way as "trackedMalloc".
+*/
+template <typename T>
+T* trackedNew(size_t count)
+{
+    T *objects = (T*)trackedMalloc(count * sizeof(T));
+    checkMallocError(objects);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        new (&objects[i]) T();
+    }
+
+    return objects;
+}
+
+/*
+Destructs and frees array of objects allocated with "trackedNew".
+*/
+template <typename T>
+void trackedDelete(T *objects)
+{
+    if (objects == NULL)
+    {
+        return;
+    }
+
+    size_t count = getTrackedSize(objects) / sizeof(T);
+    for (size_t i = 0; i < count; i++)
+    {
+        objects[i].~T();
+    }
+
+    trackedFree(objects);
+}
+
+#endif
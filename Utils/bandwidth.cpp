@@ -0,0 +1,179 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <map>
+#include <algorithm>
+
+#include "data_types_common.h"
+#include "constants_common.h"
+#include "host.h"
+#include "timer.h"
+#include "threads.h"
+#include "system_info.h"
+#include "bandwidth.h"
+
+
+/*
+Returns the name of STREAM kernel.
+*/
+const char* getStreamKernelName(stream_kernel_t kernel)
+{
+    switch (kernel)
+    {
+        case STREAM_COPY: return "copy";
+        case STREAM_SCALE: return "scale";
+        case STREAM_ADD: return "add";
+        case STREAM_TRIAD: return "triad";
+        default: return "unknown";
+    }
+}
+
+/*
+Returns the number of arrays, which are read or written by STREAM kernel.
+*/
+static uint_t getStreamKernelArrays(stream_kernel_t kernel)
+{
+    return kernel == STREAM_COPY || kernel == STREAM_SCALE ? 2 : 3;
+}
+
+/*
+Executes STREAM kernel on multiple threads and returns its time in milliseconds. Every thread processes the same
+part of arrays, which it initialized (first touch), so on NUMA machines memory is local to thread.
+*/
+static double runStreamKernel(
+    stream_kernel_t kernel, double *a, double *b, double *c, uint64_t arrayLength, uint_t numThreads
+)
+{
+    const double scalar = 3.0;
+    stopwatch_t timer;
+    startStopwatch(&timer);
+
+    parallelFor(numThreads, [&](uint_t threadIndex) {
+        uint64_t start = arrayLength * threadIndex / numThreads;
+        uint64_t end = arrayLength * (threadIndex + 1) / numThreads;
+
+        switch (kernel)
+        {
+            case STREAM_COPY:
+                for (uint64_t i = start; i < end; i++)
+                {
+                    c[i] = a[i];
+                }
+                break;
+            case STREAM_SCALE:
+                for (uint64_t i = start; i < end; i++)
+                {
+                    b[i] = scalar * c[i];
+                }
+                break;
+            case STREAM_ADD:
+                for (uint64_t i = start; i < end; i++)
+                {
+                    c[i] = a[i] + b[i];
+                }
+                break;
+            case STREAM_TRIAD:
+                for (uint64_t i = start; i < end; i++)
+                {
+                    a[i] = b[i] + scalar * c[i];
+                }
+                break;
+        }
+    });
+
+    return endStopwatch(timer);
+}
+
+/*
+Measures memory bandwidth with STREAM kernels (copy, scale, add and triad) on provided number of threads. Size of
+arrays is 4 times the size of last level cache, limited to interval from BANDWIDTH_MIN_ARRAY_SIZE to
+BANDWIDTH_MAX_ARRAY_SIZE. If upper limit prevents arrays from being 4 times larger than last level cache, kernels
+can be partly executed from cache and warning is printed, because peak bandwidth may be overestimated. Every
+kernel is repeated BANDWIDTH_REPETITIONS times and the best time is used. As in STREAM, only bytes read and
+written by kernel are counted (without write-allocate traffic).
+*/
+stream_bandwidth_t measureStreamBandwidth(uint_t numThreads)
+{
+    system_info_t systemInfo = getSystemInfo();
+    uint64_t arraySize = (std::max)(4 * systemInfo.cacheL3, (uint64_t)BANDWIDTH_MIN_ARRAY_SIZE);
+    arraySize = (std::min)(arraySize, (uint64_t)BANDWIDTH_MAX_ARRAY_SIZE);
+    uint64_t arrayLength = arraySize / sizeof(double);
+
+    if (arraySize < 4 * systemInfo.cacheL3)
+    {
+        printf(
+            "> WARNING: STREAM arrays (%.0f MB) are smaller than 4 times last level cache (%.0f MB), so peak "
+            "bandwidth may include cache hits.\n", arraySize / 1e6, 4 * systemInfo.cacheL3 / 1e6
+        );
+    }
+
+    double *a = (double*)malloc(arrayLength * sizeof(*a));
+    checkMallocError(a);
+    double *b = (double*)malloc(arrayLength * sizeof(*b));
+    checkMallocError(b);
+    double *c = (double*)malloc(arrayLength * sizeof(*c));
+    checkMallocError(c);
+
+    parallelFor(numThreads, [&](uint_t threadIndex) {
+        uint64_t start = arrayLength * threadIndex / numThreads;
+        uint64_t end = arrayLength * (threadIndex + 1) / numThreads;
+
+        for (uint64_t i = start; i < end; i++)
+        {
+            a[i] = 1.0;
+            b[i] = 2.0;
+            c[i] = 0.0;
+        }
+    });
+
+    stream_bandwidth_t bandwidth;
+    bandwidth.numThreads = numThreads;
+    bandwidth.peak = 0;
+
+    for (uint_t kernel = 0; kernel < STREAM_KERNELS_NUM; kernel++)
+    {
+        bandwidth.kernels[kernel] = 0;
+    }
+
+    // Kernels are executed in the same order as in STREAM, because every kernel reads the output of previous one
+    for (uint_t iter = 0; iter < BANDWIDTH_REPETITIONS; iter++)
+    {
+        for (uint_t kernel = 0; kernel < STREAM_KERNELS_NUM; kernel++)
+        {
+            double time = runStreamKernel((stream_kernel_t)kernel, a, b, c, arrayLength, numThreads);
+            double bytes = (double)getStreamKernelArrays((stream_kernel_t)kernel) * arrayLength * sizeof(double);
+
+            if (time > 0)
+            {
+                bandwidth.kernels[kernel] = (std::max)(bandwidth.kernels[kernel], bytes / time / 1e6);
+            }
+        }
+    }
+
+    for (uint_t kernel = 0; kernel < STREAM_KERNELS_NUM; kernel++)
+    {
+        bandwidth.peak = (std::max)(bandwidth.peak, bandwidth.kernels[kernel]);
+    }
+
+    free(a);
+    free(b);
+    free(c);
+
+    return bandwidth;
+}
+
+/*
+Returns memory bandwidth for provided number of threads. Bandwidth is measured only once for every number of
+threads (see "measureStreamBandwidth").
+*/
+stream_bandwidth_t getStreamBandwidth(uint_t numThreads)
+{
+    static std::map<uint_t, stream_bandwidth_t> bandwidths;
+
+    if (bandwidths.find(numThreads) == bandwidths.end())
+    {
+        bandwidths[numThreads] = measureStreamBandwidth(numThreads);
+    }
+
+    return bandwidths[numThreads];
+}
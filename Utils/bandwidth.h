@@ -0,0 +1,35 @@
+#ifndef BANDWIDTH_H
+#define BANDWIDTH_H
+
+#include "data_types_common.h"
+
+
+// Number of STREAM kernels
+#define STREAM_KERNELS_NUM 4
+
+enum StreamKernel
+{
+    STREAM_COPY,
+    STREAM_SCALE,
+    STREAM_ADD,
+    STREAM_TRIAD
+};
+typedef enum StreamKernel stream_kernel_t;
+
+/*
+Memory bandwidth (GB/s) achieved by STREAM kernels with provided number of threads. Peak bandwidth is the best
+bandwidth of all kernels.
+*/
+struct StreamBandwidth
+{
+    double kernels[STREAM_KERNELS_NUM];
+    double peak;
+    uint_t numThreads;
+};
+typedef struct StreamBandwidth stream_bandwidth_t;
+
+const char* getStreamKernelName(stream_kernel_t kernel);
+stream_bandwidth_t measureStreamBandwidth(uint_t numThreads);
+stream_bandwidth_t getStreamBandwidth(uint_t numThreads);
+
+#endif
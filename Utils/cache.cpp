@@ -0,0 +1,103 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <algorithm>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+#include "data_types_common.h"
+#include "constants_common.h"
+#include "host.h"
+#include "threads.h"
+#include "system_info.h"
+#include "cache.h"
+
+
+/*
+Evicts data from caches by sweeping a buffer, which is CACHE_EVICTION_FACTOR times larger than last level cache.
+Every cache line of buffer is read and written, so dirty lines of evicted data are written back to memory as well.
+Buffer is swept by all threads of multithreaded sorts, so private caches of their cores are evicted too. Buffer is
+allocated on the first call and is reused.
+*/
+void evictCaches()
+{
+    static uint8_t *buffer = NULL;
+    static uint64_t bufferSize = 0;
+
+    if (buffer == NULL)
+    {
+        system_info_t systemInfo = getSystemInfo();
+        bufferSize = (std::max)(CACHE_EVICTION_FACTOR * systemInfo.cacheL3, (uint64_t)CACHE_EVICTION_MIN_SIZE);
+        bufferSize = (std::min)(bufferSize, (uint64_t)CACHE_EVICTION_MAX_SIZE);
+
+        buffer = (uint8_t*)malloc((size_t)bufferSize);
+        checkMallocError(buffer);
+    }
+
+    uint_t numThreads = getNumThreads();
+    uint64_t numLines = bufferSize / CACHE_LINE_SIZE;
+
+    parallelFor(numThreads, [&](uint_t threadIndex) {
+        uint64_t start = numLines * threadIndex / numThreads;
+        uint64_t end = numLines * (threadIndex + 1) / numThreads;
+
+        for (uint64_t line = start; line < end; line++)
+        {
+            buffer[line * CACHE_LINE_SIZE]++;
+        }
+    });
+}
+
+/*
+Returns the size of last level cache in bytes. If size of L3 cache couldn't be read, size of L2 cache is returned.
+Size is read only on the first call.
+*/
+uint64_t getLastLevelCacheSize()
+{
+    static bool isCacheSizeRead = false;
+    static uint64_t cacheSize = 0;
+
+    if (!isCacheSizeRead)
+    {
+        system_info_t systemInfo = getSystemInfo();
+        cacheSize = systemInfo.cacheL3 > 0 ? systemInfo.cacheL3 : systemInfo.cacheL2;
+        isCacheSizeRead = true;
+    }
+
+    return cacheSize;
+}
+
+/*
+Maps anonymous memory directly from operating system, so its pages weren't touched yet and the first access to
+every page causes a page fault. Returns NULL, if memory couldn't be mapped.
+*/
+void* allocateFreshPages(size_t size)
+{
+#ifdef _WIN32
+    return VirtualAlloc(NULL, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+#else
+    void *memory = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return memory == MAP_FAILED ? NULL : memory;
+#endif
+}
+
+/*
+Unmaps memory allocated with "allocateFreshPages".
+*/
+void freeFreshPages(void *memory, size_t size)
+{
+    if (memory == NULL)
+    {
+        return;
+    }
+
+#ifdef _WIN32
+    VirtualFree(memory, 0, MEM_RELEASE);
+#else
+    munmap(memory, size);
+#endif
+}
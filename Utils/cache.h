@@ -0,0 +1,15 @@
+#ifndef CACHE_H
+#define CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "data_types_common.h"
+
+
+void evictCaches();
+uint64_t getLastLevelCacheSize();
+void* allocateFreshPages(size_t size);
+void freeFreshPages(void *memory, size_t size);
+
+#endif
@@ -10,4 +10,66 @@
 // Log2 of WARP_SIZE for faster computation because of left/right bit-shifts
 #define WARP_SIZE_LOG 5
 
+
+/* ------------- INPUT DATA DISTRIBUTIONS ------------ */
+
+// Number of buckets in bucket and staggered distributions. Equal to maximum number of threads in thread block
+// (on all CUDA devices), so input data doesn't depend on device.
+#define DISTRIBUTION_BUCKET_SIZE 1024
+
+// Exponent of Zipf (power-law) distribution. Has to be greater than 1.
+#define ZIPF_EXPONENT 1.2
+// Number of distinct values in distribution with few unique values.
+#define FEW_UNIQUE_NUM_VALUES 32
+// Percentage of elements, which are randomly swapped in nearly sorted distribution.
+#define NEARLY_SORTED_SWAP_PERCENT 1
+// Swaps in nearly sorted distribution are executed inside blocks of this size, so blocks can be generated in
+// parallel.
+#define NEARLY_SORTED_BLOCK_SIZE (1 << 20)
+// Percentage of elements in unsorted tail, which is appended to sorted sequence.
+#define SORTED_TAIL_PERCENT 10
+// Number of sorted runs in sawtooth distribution.
+#define SAWTOOTH_NUM_RUNS 64
+
+
+/* ---------------------- TIMER ---------------------- */
+
+// If true, invariant TSC (time stamp counter) is used for timing on Linux, if CPU supports it. Otherwise
+// CLOCK_MONOTONIC_RAW is used.
+#define TIMER_USE_TSC 1
+// Duration of TSC frequency calibration in milliseconds.
+#define TIMER_CALIBRATION_MS 50
+
+
+/* ---------------------- TRACE ---------------------- */
+
+// If true, phases of sorts are timed with TRACE_SCOPE and saved as Chrome trace for every sort. If false, phases
+// aren't instrumented at all (macros are empty).
+#define TRACE_ENABLED 0
+// Phases executed on subarrays (recursion levels, small sorts) are traced only for subarrays of at least this
+// length.
+#define TRACE_MIN_LENGTH (1 << 16)
+
+
+/* -------------------- BANDWIDTH -------------------- */
+
+// Memory bandwidth is measured with STREAM kernels on 3 arrays, which are 4 times larger than last level cache.
+// Size of one array (in bytes) is limited to this interval, so the probe is quick and fits into memory. If upper
+// limit is lower than 4 times last level cache, warning is printed.
+#define BANDWIDTH_MIN_ARRAY_SIZE (64 << 20)
+#define BANDWIDTH_MAX_ARRAY_SIZE (256 << 20)
+// Number of repetitions of every STREAM kernel. The best time is used.
+#define BANDWIDTH_REPETITIONS 5
+
+
+/* ---------------------- CACHE ---------------------- */
+
+// In cold cache test caches are evicted before every repetition by sweeping a buffer, which is
+// CACHE_EVICTION_FACTOR times larger than last level cache. Size of buffer (in bytes) is limited to this interval.
+#define CACHE_EVICTION_FACTOR 2
+#define CACHE_EVICTION_MIN_SIZE (32 << 20)
+#define CACHE_EVICTION_MAX_SIZE (1024 << 20)
+// Stride of cache eviction sweep in bytes (size of cache line)
+#define CACHE_LINE_SIZE 64
+
 #endif
@@ -15,13 +15,6 @@ typedef uint32_t data_t;
 #define MIN_VAL 0
 #define MAX_VAL UINT32_MAX
 
-// Determines sort order (ascending or descending)
-typedef enum SortOrder order_t;
-// Determines sort type (parallel, sequential or correct)
-typedef enum SortType sort_type_t;
-// Determines input distribution for random generator
-typedef enum DataDistribution data_dist_t;
-
 enum SortOrder
 {
     ORDER_ASC,
@@ -44,7 +37,21 @@ enum DataDistribution
     DISTRIBUTION_BUCKET,
     DISTRIBUTION_STAGGERED,
     DISTRIBUTION_SORTED_ASC,
-    DISTRIBUTION_SORTED_DESC
+    DISTRIBUTION_SORTED_DESC,
+    DISTRIBUTION_ZIPF,
+    DISTRIBUTION_FEW_UNIQUE,
+    DISTRIBUTION_NEARLY_SORTED,
+    DISTRIBUTION_SORTED_TAIL,
+    DISTRIBUTION_ORGAN_PIPE,
+    DISTRIBUTION_SAWTOOTH,
+    DISTRIBUTION_QUICKSORT_KILLER
 };
 
+// Determines sort order (ascending or descending)
+typedef enum SortOrder order_t;
+// Determines sort type (parallel, sequential or correct)
+typedef enum SortType sort_type_t;
+// Determines input distribution for random generator
+typedef enum DataDistribution data_dist_t;
+
 #endif
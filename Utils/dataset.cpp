@@ -0,0 +1,232 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "data_types_common.h"
+#include "host.h"
+#include "generator.h"
+#include "dataset.h"
+
+// Denotes that file contains completely generated dataset
+#define DATASET_MAGIC 0x5445534154414453ULL
+#define DATASET_FILE_EXTENSION ".bin"
+
+
+typedef struct DatasetHeader dataset_header_t;
+
+/*
+Header at the beginning of dataset file. Its size is 64 bytes, so keys are aligned to cache line. Magic number is
+written after keys are generated, so files, which weren't generated completely, are generated again.
+*/
+struct DatasetHeader
+{
+    uint64_t magic;
+    uint64_t seed;
+    uint32_t dataTypeBits;
+    uint32_t distribution;
+    uint32_t arrayLength;
+    uint32_t interval;
+    uint8_t padding[32];
+};
+
+
+/*
+Returns the name of dataset file.
+*/
+std::string datasetFileName(
+    std::string folderName, data_dist_t distribution, uint_t arrayLength, uint_t interval, uint64_t seed
+)
+{
+    return folderName + getDistributionName(distribution) + "_" + std::to_string(arrayLength) + "_" +
+        std::to_string(interval) + "_" + std::to_string(seed) + "_" + std::to_string(DATA_TYPE_BITS) +
+        DATASET_FILE_EXTENSION;
+}
+
+/*
+Memory-maps dataset file. If "isNewFile" is true, file is created (or truncated) to provided size and is mapped for
+writing, otherwise existing file is mapped for reading. Returns false, if existing file can't be mapped or doesn't
+have provided size.
+*/
+bool mapDatasetFile(dataset_t *dataset, std::string fileName, uint64_t fileSize, bool isNewFile)
+{
+    dataset->mappedSize = fileSize;
+
+#ifdef _WIN32
+    dataset->fileHandle = CreateFileA(
+        fileName.c_str(), isNewFile ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ, FILE_SHARE_READ, NULL,
+        isNewFile ? CREATE_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL
+    );
+    if (dataset->fileHandle == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER existingSize;
+    if (!isNewFile && (!GetFileSizeEx(dataset->fileHandle, &existingSize) || existingSize.QuadPart != fileSize))
+    {
+        CloseHandle(dataset->fileHandle);
+        return false;
+    }
+
+    dataset->mappingHandle = CreateFileMappingA(
+        dataset->fileHandle, NULL, isNewFile ? PAGE_READWRITE : PAGE_READONLY, (DWORD)(fileSize >> 32),
+        (DWORD)fileSize, NULL
+    );
+    if (dataset->mappingHandle == NULL)
+    {
+        CloseHandle(dataset->fileHandle);
+        return false;
+    }
+
+    dataset->mappedAddress = MapViewOfFile(
+        dataset->mappingHandle, isNewFile ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, (SIZE_T)fileSize
+    );
+    if (dataset->mappedAddress == NULL)
+    {
+        CloseHandle(dataset->mappingHandle);
+        CloseHandle(dataset->fileHandle);
+        return false;
+    }
+#else
+    dataset->fileDescriptor = open(fileName.c_str(), isNewFile ? O_RDWR | O_CREAT | O_TRUNC : O_RDONLY, 0644);
+    if (dataset->fileDescriptor < 0)
+    {
+        return false;
+    }
+
+    struct stat fileStat;
+    if (isNewFile ? ftruncate(dataset->fileDescriptor, (off_t)fileSize) != 0 : (
+            fstat(dataset->fileDescriptor, &fileStat) != 0 || (uint64_t)fileStat.st_size != fileSize
+        ))
+    {
+        close(dataset->fileDescriptor);
+        return false;
+    }
+
+    dataset->mappedAddress = mmap(
+        NULL, (size_t)fileSize, isNewFile ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED,
+        dataset->fileDescriptor, 0
+    );
+    if (dataset->mappedAddress == MAP_FAILED)
+    {
+        close(dataset->fileDescriptor);
+        return false;
+    }
+#endif
+
+    return true;
+}
+
+/*
+Unmaps dataset file.
+*/
+void unmapDatasetFile(dataset_t *dataset)
+{
+#ifdef _WIN32
+    UnmapViewOfFile(dataset->mappedAddress);
+    CloseHandle(dataset->mappingHandle);
+    CloseHandle(dataset->fileHandle);
+#else
+    munmap(dataset->mappedAddress, (size_t)dataset->mappedSize);
+    close(dataset->fileDescriptor);
+#endif
+
+    dataset->mappedAddress = NULL;
+    dataset->keys = NULL;
+}
+
+/*
+Checks if header of mapped dataset file matches provided parameters.
+*/
+bool isDatasetValid(
+    dataset_header_t *header, data_dist_t distribution, uint_t arrayLength, uint_t interval, uint64_t seed
+)
+{
+    return header->magic == DATASET_MAGIC && header->seed == seed && header->dataTypeBits == DATA_TYPE_BITS &&
+        header->distribution == distribution && header->arrayLength == arrayLength && header->interval == interval;
+}
+
+/*
+Opens dataset with provided parameters. Persistent dataset is generated directly into memory-mapped file, if file
+doesn't exist yet (or is invalid). Other datasets are generated into memory and aren't saved, so runs with
+generated seeds don't leave files behind. Dataset has to be closed with "closeDataset".
+*/
+void openDataset(
+    dataset_t *dataset, std::string folderName, data_dist_t distribution, uint_t arrayLength, uint_t interval,
+    uint64_t seed, bool isPersistent
+)
+{
+    std::string fileName = datasetFileName(folderName, distribution, arrayLength, interval, seed);
+    uint64_t fileSize = sizeof(dataset_header_t) + (uint64_t)arrayLength * sizeof(data_t);
+
+    dataset->arrayLength = arrayLength;
+    dataset->seed = seed;
+    dataset->isPersistent = isPersistent;
+    dataset->mappedAddress = NULL;
+
+    if (!isPersistent)
+    {
+        dataset->keys = (data_t*)malloc((size_t)arrayLength * sizeof(*dataset->keys));
+        checkMallocError(dataset->keys);
+        fillArrayKeyOnly(dataset->keys, arrayLength, interval, distribution, seed);
+        return;
+    }
+
+    // Dataset was already generated
+    if (mapDatasetFile(dataset, fileName, fileSize, false))
+    {
+        dataset_header_t *header = (dataset_header_t*)dataset->mappedAddress;
+        dataset->keys = (data_t*)(header + 1);
+
+        if (isDatasetValid(header, distribution, arrayLength, interval, seed))
+        {
+            return;
+        }
+
+        unmapDatasetFile(dataset);
+    }
+
+    if (!mapDatasetFile(dataset, fileName, fileSize, true))
+    {
+        printf("Error creating dataset file: %s\n", fileName.c_str());
+        getchar();
+        exit(EXIT_FAILURE);
+    }
+
+    dataset_header_t *header = (dataset_header_t*)dataset->mappedAddress;
+    dataset->keys = (data_t*)(header + 1);
+    fillArrayKeyOnly(dataset->keys, arrayLength, interval, distribution, seed);
+
+    header->seed = seed;
+    header->dataTypeBits = DATA_TYPE_BITS;
+    header->distribution = distribution;
+    header->arrayLength = arrayLength;
+    header->interval = interval;
+    header->magic = DATASET_MAGIC;
+}
+
+/*
+Closes dataset and unmaps its file (or frees its memory, if dataset isn't persistent).
+*/
+void closeDataset(dataset_t *dataset)
+{
+    if (!dataset->isPersistent)
+    {
+        free(dataset->keys);
+        dataset->keys = NULL;
+    }
+    else if (dataset->mappedAddress != NULL)
+    {
+        unmapDatasetFile(dataset);
+    }
+}
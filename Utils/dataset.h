@@ -0,0 +1,46 @@
+#ifndef DATASET_H
+#define DATASET_H
+
+#include <stdint.h>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#include "data_types_common.h"
+
+
+typedef struct Dataset dataset_t;
+
+/*
+Input data, which is generated only once, so the same snapshot of input data can be copied to array before every
+sort. Every dataset is determined by distribution, array length, interval and seed. Persistent dataset is saved to
+binary file, which is memory-mapped and reused by later runs with the same seed. Other datasets are kept only in
+memory.
+*/
+struct Dataset
+{
+    data_t *keys;
+    uint_t arrayLength;
+    uint64_t seed;
+    bool isPersistent;
+
+    // Handles needed to unmap file
+    void *mappedAddress;
+    uint64_t mappedSize;
+#ifdef _WIN32
+    HANDLE fileHandle;
+    HANDLE mappingHandle;
+#else
+    int fileDescriptor;
+#endif
+};
+
+void openDataset(
+    dataset_t *dataset, std::string folderName, data_dist_t distribution, uint_t arrayLength, uint_t interval,
+    uint64_t seed, bool isPersistent
+);
+void closeDataset(dataset_t *dataset);
+
+#endif
@@ -5,6 +5,12 @@
 #include <string>
 #include <sstream>
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/stat.h>
+#endif
+
 #include "../Utils/data_types_common.h"
 #include "../Utils/host.h"
 
@@ -12,9 +18,13 @@
 /*
 Creates folder if it doesn't already exist.
 */
-bool createFolder(char* folderName)
+bool createFolder(const char* folderName)
 {
+#ifdef _WIN32
     return CreateDirectory(folderName, NULL);
+#else
+    return mkdir(folderName, 0755) == 0;
+#endif
 }
 
 /*
@@ -22,7 +32,7 @@ Creates folder if it doesn't already exist.
 */
 bool createFolder(std::string folderName)
 {
-    return CreateDirectory(folderName.c_str(), NULL);
+    return createFolder(folderName.c_str());
 }
 
 /*
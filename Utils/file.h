@@ -5,7 +5,7 @@
 #include "../Utils/sort_interface.h"
 
 
-bool createFolder(char* folderName);
+bool createFolder(const char* folderName);
 bool createFolder(std::string folderName);
 void readArrayFromFile(char *fileName, data_t *keys, uint_t arrayLength);
 void readArrayFromFile(std::string fileName, data_t *keys, uint_t arrayLength);
@@ -1,148 +1,405 @@
 #include <stdio.h>
+#include <stdlib.h>
 #include <stdint.h>
-#include <random>
-#include <iostream>
-#include <functional>
+#include <math.h>
 #include <chrono>
-#include <stdint.h>
+#include <algorithm>
 
 #include "data_types_common.h"
-#include "cuda.h"
-#include "sort_correct.h"
+#include "constants_common.h"
+#include "threads.h"
+#include "host.h"
 
 using namespace std;
 
-// Needed to ensure different seed every time
-uint_t generatorCalls = 0;
 
+/*
+Returns random 64-bit number with index "counter" in sequence determined by seed. Numbers are generated with
+counter-based generator SplitMix64: every number is computed directly from seed and its index, so any range of
+numbers can be generated independently from other ranges (in parallel threads).
+*/
+inline uint64_t randomNumber(uint64_t seed, uint64_t counter)
+{
+    uint64_t z = seed + (counter + 1) * 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
 
 /*
-Fills keys with random numbers.
-TODO break into separate function for every distribution (currently having difficulties due to "auto" data type).
+Returns random key on interval [0, interval] with index "counter" in sequence determined by seed.
 */
-void fillArrayKeyOnly(data_t *keys, uint_t tableLen, uint_t interval, uint_t bucketSize, data_dist_t distribution)
+inline data_t randomKey(uint64_t seed, uint64_t counter, uint_t interval)
 {
-    auto seed = chrono::high_resolution_clock::now().time_since_epoch().count() + generatorCalls++;
+    uint64_t number = randomNumber(seed, counter);
+
 #if DATA_TYPE_BITS == 32
-    auto generator = std::bind(std::uniform_int_distribution<data_t>(0, interval), mt19937(seed));
+    // Upper 32 bits are mapped to interval with multiplication instead of division
+    return (data_t)(((number >> 32) * ((uint64_t)interval + 1)) >> 32);
 #else
-    auto generator = std::bind(std::uniform_int_distribution<data_t>(0, interval), mt19937_64(seed));
+    return (data_t)(number % ((uint64_t)interval + 1));
 #endif
+}
 
-    switch (distribution)
+/*
+Returns key with index "i" in sorted (ascending) sequence of length "tableLen". Interval of values is divided into
+"tableLen" equal parts and key "i" is a random number from part "i". This way sequence doesn't have to be sorted
+after it is generated.
+*/
+inline data_t sortedKey(uint64_t seed, uint_t i, uint_t tableLen, uint_t interval)
+{
+    uint64_t partStart = ((uint64_t)interval + 1) * i / tableLen;
+    uint64_t partEnd = ((uint64_t)interval + 1) * (i + 1) / tableLen;
+
+    if (partEnd - partStart <= 1)
     {
-        case DISTRIBUTION_UNIFORM:
-        {
-            for (uint_t i = 0; i < tableLen; i++)
-            {
-                keys[i] = generator();
-            }
+        return (data_t)partStart;
+    }
 
-            break;
+    return (data_t)(partStart + randomNumber(seed, i) % (partEnd - partStart));
+}
+
+/*
+Fills array in parallel. Array is divided into equal chunks, one for every thread. Function receives the index of
+element and returns its key.
+*/
+template <typename Function>
+void fillArrayParallel(data_t *keys, uint_t tableLen, Function function)
+{
+    uint_t numThreads = getNumThreads();
+
+    parallelFor(numThreads, [&](uint_t threadIndex) {
+        uint_t chunkStart = (uint_t)((uint64_t)tableLen * threadIndex / numThreads);
+        uint_t chunkEnd = (uint_t)((uint64_t)tableLen * (threadIndex + 1) / numThreads);
+
+        for (uint_t i = chunkStart; i < chunkEnd; i++)
+        {
+            keys[i] = function(i);
         }
-        case DISTRIBUTION_GAUSSIAN:
+    });
+}
+
+/*
+Fills keys with uniformly distributed random numbers.
+*/
+void fillArrayUniform(data_t *keys, uint_t tableLen, uint_t interval, uint64_t seed)
+{
+    fillArrayParallel(keys, tableLen, [=](uint_t i) {
+        return randomKey(seed, i, interval);
+    });
+}
+
+/*
+Fills keys with random numbers, which are averages of multiple uniformly distributed random numbers.
+*/
+void fillArrayGaussian(data_t *keys, uint_t tableLen, uint_t interval, uint64_t seed)
+{
+    // How many values are used for average when generating random numbers
+    const uint_t numValues = 4;
+
+    fillArrayParallel(keys, tableLen, [=](uint_t i) {
+        uint64_t sum = 0;
+
+        for (uint_t j = 0; j < numValues; j++)
         {
-            double numValues = 4;  // How many values are used for average when generating random numbers
+            sum += randomKey(seed, (uint64_t)i * numValues + j, interval);
+        }
 
-            for (uint_t i = 0; i < tableLen; i++)
-            {
-                data_t sum = 0;
+        return (data_t)(sum / numValues);
+    });
+}
 
-                for (uint_t j = 0; j < numValues; j++)
-                {
-                    sum += generator();
-                }
+/*
+Fills keys with the same random number.
+*/
+void fillArrayZero(data_t *keys, uint_t tableLen, uint_t interval, uint64_t seed)
+{
+    data_t value = randomKey(seed, 0, interval);
 
-                keys[i] = sum / numValues;
-            }
+    fillArrayParallel(keys, tableLen, [=](uint_t) {
+        return value;
+    });
+}
 
-            break;
+/*
+Divides array into "bucketSize" groups, each of them containing "bucketSize" buckets. Bucket "j" in every group is
+filled with random numbers from "j-th" interval of values. The rest of the array is filled with uniformly
+distributed random numbers.
+*/
+void fillArrayBucket(data_t *keys, uint_t tableLen, uint_t interval, uint_t bucketSize, uint64_t seed)
+{
+    uint_t elemsPerBucket = tableLen / bucketSize / bucketSize;
+    uint_t elemsBuckets = elemsPerBucket * bucketSize * bucketSize;
+    data_t bucketIncrement = (MAX_VAL / bucketSize + 1);
+
+    fillArrayParallel(keys, tableLen, [=](uint_t i) {
+        if (i >= elemsBuckets)
+        {
+            return randomKey(seed, i, interval);
         }
-        case DISTRIBUTION_ZERO:
+
+        uint_t bucket = (i / elemsPerBucket) % bucketSize;
+        return (data_t)(bucket * bucketIncrement + (randomKey(seed, i, interval) % bucketIncrement));
+    });
+}
+
+/*
+Divides array into "bucketSize" buckets. First half of buckets is filled with random numbers from interval above all
+other buckets, the second half of buckets is filled with numbers from increasing intervals. The rest of the array is
+filled with uniformly distributed random numbers.
+*/
+void fillArrayStaggered(data_t *keys, uint_t tableLen, uint_t interval, uint_t bucketSize, uint64_t seed)
+{
+    uint_t elemsPerBucket = tableLen / bucketSize;
+    uint_t elemsBuckets = elemsPerBucket * bucketSize;
+
+    fillArrayParallel(keys, tableLen, [=](uint_t i) {
+        if (i >= elemsBuckets)
         {
-            data_t value = generator();
+            return randomKey(seed, i, interval);
+        }
 
-            for (uint_t i = 0; i < tableLen; i++)
-            {
-                keys[i] = value;
-            }
+        uint_t bucket = i / elemsPerBucket;
+        data_t bucketIncrement;
 
-            break;
+        if (bucket < (bucketSize / 2))
+        {
+            bucketIncrement = 2 * bucketSize + 1;
         }
-        case DISTRIBUTION_BUCKET:
+        else
         {
-            uint_t index = 0;
-            data_t bucketIncrement = (MAX_VAL / bucketSize + 1);
+            bucketIncrement = (bucket - (bucketSize / 2)) * 2;
+        }
 
-            // Fills the buckets
-            for (uint_t i = 0; i < bucketSize; i++)
-            {
-                for (uint_t j = 0; j < bucketSize; j++)
-                {
-                    for (uint_t k = 0; k < tableLen / bucketSize / bucketSize; k++)
-                    {
-                        keys[index++] = (data_t)(j * bucketIncrement + (generator() >> bucketSize));
-                    }
-                }
-            }
+        bucketIncrement = bucketIncrement * ((MAX_VAL / bucketSize) + 1);
+        return (data_t)(bucketIncrement + (randomKey(seed, i, interval) / bucketSize) + 1);
+    });
+}
 
-            // Fills the rest of the data into table
-            for (; index < tableLen; index++)
-            {
-                keys[index] = generator();
-            }
+/*
+Fills keys with sorted sequence of random numbers.
+*/
+void fillArraySorted(data_t *keys, uint_t tableLen, uint_t interval, order_t sortOrder, uint64_t seed)
+{
+    fillArrayParallel(keys, tableLen, [=](uint_t i) {
+        return sortedKey(seed, sortOrder == ORDER_ASC ? i : tableLen - 1 - i, tableLen, interval);
+    });
+}
 
-            break;
-        }
-        case DISTRIBUTION_STAGGERED:
+/*
+Fills keys with random numbers from Zipf (power-law) distribution - small values are much more frequent than large
+values. Numbers are generated with inverse of cumulative distribution function of continuous power-law distribution
+on interval [1, interval + 1].
+*/
+void fillArrayZipf(data_t *keys, uint_t tableLen, uint_t interval, uint64_t seed)
+{
+    double exponent = 1 - ZIPF_EXPONENT;
+    double maxPower = pow((double)interval + 1, exponent);
+
+    fillArrayParallel(keys, tableLen, [=](uint_t i) {
+        // Uniformly distributed random number on interval [0, 1)
+        double random = (randomNumber(seed, i) >> 11) * (1.0 / 9007199254740992.0);
+        double value = pow(1 - random * (1 - maxPower), 1 / exponent) - 1;
+
+        return (data_t)min(value, (double)interval);
+    });
+}
+
+/*
+Fills keys with random numbers, which are chosen from a small set of distinct random values.
+*/
+void fillArrayFewUnique(data_t *keys, uint_t tableLen, uint_t interval, uint64_t seed)
+{
+    fillArrayParallel(keys, tableLen, [=](uint_t i) {
+        data_t valueIndex = randomKey(seed, i, FEW_UNIQUE_NUM_VALUES - 1);
+        return randomKey(~seed, valueIndex, interval);
+    });
+}
+
+/*
+Fills keys with sorted sequence, in which random pairs of elements are swapped. Array is divided into blocks, which
+are processed in parallel. Pairs are chosen inside blocks, so result doesn't depend on the number of threads.
+*/
+void fillArrayNearlySorted(data_t *keys, uint_t tableLen, uint_t interval, uint64_t seed)
+{
+    uint_t numThreads = getNumThreads();
+    uint_t numBlocks = (tableLen + NEARLY_SORTED_BLOCK_SIZE - 1) / NEARLY_SORTED_BLOCK_SIZE;
+
+    fillArraySorted(keys, tableLen, interval, ORDER_ASC, seed);
+
+    parallelFor(numThreads, [&](uint_t threadIndex) {
+        for (uint_t block = threadIndex; block < numBlocks; block += numThreads)
         {
-            uint_t index = 0;
+            uint_t blockStart = block * NEARLY_SORTED_BLOCK_SIZE;
+            uint_t blockLength = min(tableLen - blockStart, (uint_t)NEARLY_SORTED_BLOCK_SIZE);
+            uint_t numSwaps = (uint_t)((uint64_t)blockLength * NEARLY_SORTED_SWAP_PERCENT / 100);
 
-            for (uint_t i = 0; i < bucketSize; i++)
+            for (uint_t swap = 0; swap < numSwaps; swap++)
             {
-                uint_t j;
-                data_t bucketIncrement;
-
-                if (i < (bucketSize / 2))
-                {
-                    bucketIncrement = 2 * bucketSize + 1;
-                }
-                else
-                {
-                    bucketIncrement = (i - (bucketSize / 2)) * 2;
-                }
-
-                bucketIncrement = bucketIncrement * ((MAX_VAL / bucketSize) + 1);
-
-                for (j = 0; j < tableLen / bucketSize; j++)
-                {
-                    keys[index++] = bucketIncrement + ((generator()) / bucketSize) + 1;
-                }
-            }
+                uint64_t counter = 2 * ((uint64_t)blockStart + swap);
+                uint_t index1 = blockStart + randomNumber(~seed, counter) % blockLength;
+                uint_t index2 = blockStart + randomNumber(~seed, counter + 1) % blockLength;
 
-            for (; index < tableLen; index++)
-            {
-                keys[index] = generator();
+                std::swap(keys[index1], keys[index2]);
             }
+        }
+    });
+}
+
+/*
+Fills keys with sorted sequence, which is followed by unsorted tail of uniformly distributed random numbers.
+*/
+void fillArraySortedTail(data_t *keys, uint_t tableLen, uint_t interval, uint64_t seed)
+{
+    uint_t sortedLength = tableLen - (uint_t)((uint64_t)tableLen * SORTED_TAIL_PERCENT / 100);
+
+    fillArrayParallel(keys, tableLen, [=](uint_t i) {
+        return i < sortedLength ? sortedKey(seed, i, sortedLength, interval) : randomKey(seed, i, interval);
+    });
+}
+
+/*
+Fills keys with organ pipe sequence - first half of array is sorted in ascending order and the second half in
+descending order.
+*/
+void fillArrayOrganPipe(data_t *keys, uint_t tableLen, uint_t interval, uint64_t seed)
+{
+    uint_t halfLength = tableLen - tableLen / 2;
+
+    fillArrayParallel(keys, tableLen, [=](uint_t i) {
+        if (i < halfLength)
+        {
+            return sortedKey(seed, i, halfLength, interval);
+        }
+        return sortedKey(~seed, tableLen - 1 - i, tableLen - halfLength, interval);
+    });
+}
+
+/*
+Fills keys with sawtooth sequence - array consists of multiple runs, which are sorted in ascending order.
+*/
+void fillArraySawtooth(data_t *keys, uint_t tableLen, uint_t interval, uint64_t seed)
+{
+    uint_t runLength = (tableLen - 1) / SAWTOOTH_NUM_RUNS + 1;
+
+    fillArrayParallel(keys, tableLen, [=](uint_t i) {
+        uint_t run = i / runLength;
+        uint_t runStart = run * runLength;
 
+        return sortedKey(seed + run, i - runStart, min(runLength, tableLen - runStart), interval);
+    });
+}
+
+/*
+Fills keys with median-of-3 killer sequence (D. R. Musser, Introspective sorting and selection algorithms), which
+causes quadratic time complexity in quicksort, which chooses pivot as median of first, middle and last element.
+Sequence doesn't depend on seed.
+*/
+void fillArrayQuicksortKiller(data_t *keys, uint_t tableLen, uint_t interval)
+{
+    uint_t halfLength = tableLen / 2;
+    // Distance between consecutive values, so that all values fit into interval
+    uint64_t step = max(((uint64_t)interval + 1) / max(tableLen, (uint_t)1), (uint64_t)1);
+
+    fillArrayParallel(keys, tableLen, [=](uint_t i) {
+        // Musser's construction is defined with indexes and values starting with 1
+        uint64_t index = (uint64_t)i + 1;
+        uint64_t value;
+
+        if (index <= halfLength)
+        {
+            value = index % 2 == 1 ? index : halfLength + index - 1;
+        }
+        else if (index <= 2 * halfLength)
+        {
+            value = 2 * (index - halfLength);
+        }
+        else
+        {
+            value = tableLen;
+        }
+
+        return (data_t)min((value - 1) * step, (uint64_t)interval);
+    });
+}
+
+/*
+Fills keys with random numbers. The same seed always generates the same array.
+*/
+void fillArrayKeyOnly(
+    data_t *keys, uint_t tableLen, uint_t interval, uint_t bucketSize, data_dist_t distribution, uint64_t seed
+)
+{
+    switch (distribution)
+    {
+        case DISTRIBUTION_UNIFORM:
+        {
+            fillArrayUniform(keys, tableLen, interval, seed);
+            break;
+        }
+        case DISTRIBUTION_GAUSSIAN:
+        {
+            fillArrayGaussian(keys, tableLen, interval, seed);
+            break;
+        }
+        case DISTRIBUTION_ZERO:
+        {
+            fillArrayZero(keys, tableLen, interval, seed);
+            break;
+        }
+        case DISTRIBUTION_BUCKET:
+        {
+            fillArrayBucket(keys, tableLen, interval, bucketSize, seed);
+            break;
+        }
+        case DISTRIBUTION_STAGGERED:
+        {
+            fillArrayStaggered(keys, tableLen, interval, bucketSize, seed);
             break;
         }
         case DISTRIBUTION_SORTED_ASC:
         {
-            for (uint_t i = 0; i < tableLen; i++)
-            {
-                keys[i] = generator();
-            }
-            sortCorrect(keys, tableLen, ORDER_ASC);
+            fillArraySorted(keys, tableLen, interval, ORDER_ASC, seed);
             break;
         }
         case DISTRIBUTION_SORTED_DESC:
         {
-            for (uint_t i = 0; i < tableLen; i++)
-            {
-                keys[i] = generator();
-            }
-            sortCorrect(keys, tableLen, ORDER_DESC);
+            fillArraySorted(keys, tableLen, interval, ORDER_DESC, seed);
+            break;
+        }
+        case DISTRIBUTION_ZIPF:
+        {
+            fillArrayZipf(keys, tableLen, interval, seed);
+            break;
+        }
+        case DISTRIBUTION_FEW_UNIQUE:
+        {
+            fillArrayFewUnique(keys, tableLen, interval, seed);
+            break;
+        }
+        case DISTRIBUTION_NEARLY_SORTED:
+        {
+            fillArrayNearlySorted(keys, tableLen, interval, seed);
+            break;
+        }
+        case DISTRIBUTION_SORTED_TAIL:
+        {
+            fillArraySortedTail(keys, tableLen, interval, seed);
+            break;
+        }
+        case DISTRIBUTION_ORGAN_PIPE:
+        {
+            fillArrayOrganPipe(keys, tableLen, interval, seed);
+            break;
+        }
+        case DISTRIBUTION_SAWTOOTH:
+        {
+            fillArraySawtooth(keys, tableLen, interval, seed);
+            break;
+        }
+        case DISTRIBUTION_QUICKSORT_KILLER:
+        {
+            fillArrayQuicksortKiller(keys, tableLen, interval);
             break;
         }
         default:
@@ -157,9 +414,9 @@ void fillArrayKeyOnly(data_t *keys, uint_t tableLen, uint_t interval, uint_t buc
 /*
 Fills keys with random values on provided interval.
 */
-void fillArrayKeyOnly(data_t *keys, uint_t tableLen, uint_t interval, data_dist_t distribution)
+void fillArrayKeyOnly(data_t *keys, uint_t tableLen, uint_t interval, data_dist_t distribution, uint64_t seed)
 {
-    fillArrayKeyOnly(keys, tableLen, interval, getMaxThreadsPerBlock(), distribution);
+    fillArrayKeyOnly(keys, tableLen, interval, DISTRIBUTION_BUCKET_SIZE, distribution, seed);
 }
 
 /*
@@ -167,17 +424,26 @@ Fills array with sequential (consequently unique) values.
 */
 void fillArrayValueOnly(data_t *values, uint_t tableLen)
 {
-    for (uint_t i = 0; i < tableLen; i++)
-    {
-        values[i] = i;
-    }
+    fillArrayParallel(values, tableLen, [](uint_t i) {
+        return (data_t)i;
+    });
 }
 
 /*
 Fills keys with random numbers and values with consecutive values (for stability test).
 */
-void fillArrayKeyValue(data_t *keys, data_t *values, uint_t tableLen, uint_t interval, data_dist_t distribution)
+void fillArrayKeyValue(
+    data_t *keys, data_t *values, uint_t tableLen, uint_t interval, data_dist_t distribution, uint64_t seed
+)
 {
-    fillArrayKeyOnly(keys, tableLen, interval, distribution);
+    fillArrayKeyOnly(keys, tableLen, interval, distribution, seed);
     fillArrayValueOnly(values, tableLen);
 }
+
+/*
+Generates seed from current time. Used, when seed isn't provided by user.
+*/
+uint64_t generateSeed()
+{
+    return (uint64_t)chrono::high_resolution_clock::now().time_since_epoch().count();
+}
@@ -1,12 +1,19 @@
 #ifndef GENERATOR_H
 #define GENERATOR_H
 
+#include <stdint.h>
+
 #include "data_types_common.h"
 
 
-void fillArrayKeyOnly(data_t *keys, uint_t tableLen, uint_t interval, data_dist_t distribution);
-void fillArrayKeyOnly(data_t *keys, uint_t tableLen, uint_t interval, uint_t bucketSize, data_dist_t distribution);
+void fillArrayKeyOnly(data_t *keys, uint_t tableLen, uint_t interval, data_dist_t distribution, uint64_t seed);
+void fillArrayKeyOnly(
+    data_t *keys, uint_t tableLen, uint_t interval, uint_t bucketSize, data_dist_t distribution, uint64_t seed
+);
 void fillArrayValueOnly(data_t *values, uint_t tableLen);
-void fillArrayKeyValue(data_t *keys, data_t *values, uint_t tableLen, uint_t interval, data_dist_t distribution);
+void fillArrayKeyValue(
+    data_t *keys, data_t *values, uint_t tableLen, uint_t interval, data_dist_t distribution, uint64_t seed
+);
+uint64_t generateSeed();
 
 #endif
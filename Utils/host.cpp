@@ -2,54 +2,10 @@
 #include <stdint.h>
 #include <string.h>
 #include <random>
-#include <Windows.h>
-
-#include <cuda.h>
-#include "cuda_runtime.h"
-#include "device_launch_parameters.h"
 
 #include "data_types_common.h"
 
 
-/*
-Starts the stopwatch (remembers the current time).
-*/
-void startStopwatch(LARGE_INTEGER* start)
-{
-    QueryPerformanceCounter(start);
-}
-
-/*
-Ends the stopwatch (calculates the difference between current time and parameter "start") and returns time
-in milliseconds. Also prints out comment.
-*/
-double endStopwatch(LARGE_INTEGER start, char* comment)
-{
-    LARGE_INTEGER frequency;
-    LARGE_INTEGER end;
-    double elapsedTime;
-
-    QueryPerformanceFrequency(&frequency);
-    QueryPerformanceCounter(&end);
-    elapsedTime = (end.QuadPart - start.QuadPart) * 1000.0 / frequency.QuadPart;
-
-    if (comment != NULL)
-    {
-        printf("%s: %.5lf ms\n", comment, elapsedTime);
-    }
-
-    return elapsedTime;
-}
-
-/*
-Ends the stopwatch (calculates the difference between current time and parameter "start") and returns time
-in milliseconds.
-*/
-double endStopwatch(LARGE_INTEGER start)
-{
-    return endStopwatch(start, NULL);
-}
-
 /*
 Compares two arrays and prints out if they are the same or if they differ.
 */
@@ -73,7 +29,7 @@ void printTable(data_t *table, uint_t startIndex, uint_t endIndex)
 {
     for (uint_t i = startIndex; i <= endIndex; i++)
     {
-        char* separator = i == endIndex ? "" : ", ";
+        const char* separator = i == endIndex ? "" : ", ";
         printf("%2d%s", table[i], separator);
     }
 
@@ -171,7 +127,7 @@ int roundUp(int numToRound, int multiple)
 /*
 According to provided distribution returns distribution name.
 */
-char* getDistributionName(data_dist_t distribution)
+const char* getDistributionName(data_dist_t distribution)
 {
     switch (distribution)
     {
@@ -181,7 +137,14 @@ char* getDistributionName(data_dist_t distribution)
         case DISTRIBUTION_BUCKET: return "bucket";
         case DISTRIBUTION_STAGGERED: return "staggered";
         case DISTRIBUTION_SORTED_ASC: return "sorted_asc";
-        case DISTRIBUTION_SORTED_DESC: return "sorder_desc";
+        case DISTRIBUTION_SORTED_DESC: return "sorted_desc";
+        case DISTRIBUTION_ZIPF: return "zipf";
+        case DISTRIBUTION_FEW_UNIQUE: return "few_unique";
+        case DISTRIBUTION_NEARLY_SORTED: return "nearly_sorted";
+        case DISTRIBUTION_SORTED_TAIL: return "sorted_tail";
+        case DISTRIBUTION_ORGAN_PIPE: return "organ_pipe";
+        case DISTRIBUTION_SAWTOOTH: return "sawtooth";
+        case DISTRIBUTION_QUICKSORT_KILLER: return "quicksort_killer";
         default:
             printf("Invalid distribution");
             exit(EXIT_FAILURE);
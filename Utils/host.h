@@ -1,12 +1,31 @@
 #ifndef HOST_UTILS_H
 #define HOST_UTILS_H
 
-#include <windows.h>
 #include <string>
+#include <type_traits>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#include "timer.h"
+
+// Functions "min" and "max" are otherwise provided by CUDA headers, which aren't included in CPU-only build. Names
+// are in parentheses, so they aren't expanded by macros from "windows.h".
+#ifndef __CUDACC__
+template <typename T1, typename T2>
+inline typename std::common_type<T1, T2>::type (min)(T1 a, T2 b)
+{
+    return a < b ? a : b;
+}
+
+template <typename T1, typename T2>
+inline typename std::common_type<T1, T2>::type (max)(T1 a, T2 b)
+{
+    return a > b ? a : b;
+}
+#endif
 
-void startStopwatch(LARGE_INTEGER* start);
-double endStopwatch(LARGE_INTEGER start, char* comment);
-double endStopwatch(LARGE_INTEGER start);
 bool compareArrays(data_t* array1, data_t* array2, uint_t arrayLen);
 void printTable(data_t *table, uint_t tableLen);
 void printTable(data_t *table, uint_t startIndex, uint_t endIndex);
@@ -15,7 +34,7 @@ bool isPowerOfTwo(uint_t value);
 uint_t nextPowerOf2(uint_t value);
 uint_t previousPowerOf2(uint_t value);
 int roundUp(int numToRound, int multiple);
-char* getDistributionName(data_dist_t distribution);
+const char* getDistributionName(data_dist_t distribution);
 std::string strCapitalize(std::string str);
 std::string strReplace(std::string text, char from, char to);
 std::string strSlugify(std::string text);
@@ -0,0 +1,283 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+#include "data_types_common.h"
+#include "threads.h"
+#include "perf_counters.h"
+
+
+/*
+Returns the name of hardware performance counter.
+*/
+const char* getPerfCounterName(perf_counter_t counter)
+{
+    switch (counter)
+    {
+        case PERF_COUNTER_CYCLES: return "cycles";
+        case PERF_COUNTER_INSTRUCTIONS: return "instructions";
+        case PERF_COUNTER_BRANCH_MISSES: return "branch_misses";
+        case PERF_COUNTER_LLC_LOAD_MISSES: return "llc_load_misses";
+        case PERF_COUNTER_DTLB_LOAD_MISSES: return "dtlb_load_misses";
+        default:
+            printf("Invalid performance counter");
+            exit(EXIT_FAILURE);
+            return "";
+    }
+}
+
+#ifdef __linux__
+
+/*
+Group of hardware performance counters of one thread. Cycles are the group leader, so all counters in group are
+scheduled onto the PMU together. If some counter isn't supported, it is left out of the group.
+*/
+struct PerfCounterGroup
+{
+    int fileDescriptors[PERF_COUNTERS_NUM];
+    // Values read when counting was started
+    uint64_t valuesStart[PERF_COUNTERS_NUM];
+    uint64_t timeEnabledStart;
+    uint64_t timeRunningStart;
+};
+
+// Groups of counters of all threads. Group with index "i" measures the thread with thread index "i" (of
+// "parallelFor"), because multithreaded sorts execute work also on pool threads.
+std::vector<PerfCounterGroup> perfCounterGroups;
+// Denotes if counters could be opened at all
+bool perfCountersSupported = true;
+
+
+/*
+Returns type and config of performance event for provided counter.
+*/
+static void getPerfEventConfig(perf_counter_t counter, __u32 *type, __u64 *config)
+{
+    __u64 cacheLoadMiss = (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+
+    switch (counter)
+    {
+        case PERF_COUNTER_CYCLES:
+            *type = PERF_TYPE_HARDWARE;
+            *config = PERF_COUNT_HW_CPU_CYCLES;
+            break;
+        case PERF_COUNTER_INSTRUCTIONS:
+            *type = PERF_TYPE_HARDWARE;
+            *config = PERF_COUNT_HW_INSTRUCTIONS;
+            break;
+        case PERF_COUNTER_BRANCH_MISSES:
+            *type = PERF_TYPE_HARDWARE;
+            *config = PERF_COUNT_HW_BRANCH_MISSES;
+            break;
+        case PERF_COUNTER_LLC_LOAD_MISSES:
+            *type = PERF_TYPE_HW_CACHE;
+            *config = PERF_COUNT_HW_CACHE_LL | cacheLoadMiss;
+            break;
+        case PERF_COUNTER_DTLB_LOAD_MISSES:
+            *type = PERF_TYPE_HW_CACHE;
+            *config = PERF_COUNT_HW_CACHE_DTLB | cacheLoadMiss;
+            break;
+    }
+}
+
+/*
+Opens counter for calling thread on any CPU. Returns -1, if counter is not available.
+*/
+static int openPerfEvent(perf_counter_t counter, int groupFileDescriptor)
+{
+    struct perf_event_attr attributes;
+    memset(&attributes, 0, sizeof(attributes));
+    attributes.size = sizeof(attributes);
+    getPerfEventConfig(counter, &attributes.type, &attributes.config);
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    attributes.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    return (int)syscall(SYS_perf_event_open, &attributes, 0, -1, groupFileDescriptor, 0);
+}
+
+/*
+Opens the group of counters for calling thread.
+*/
+static void openPerfCounterGroup(PerfCounterGroup *group)
+{
+    for (uint_t i = 0; i < PERF_COUNTERS_NUM; i++)
+    {
+        group->fileDescriptors[i] = -1;
+    }
+
+    int leader = openPerfEvent(PERF_COUNTER_CYCLES, -1);
+    if (leader < 0)
+    {
+        return;
+    }
+
+    group->fileDescriptors[PERF_COUNTER_CYCLES] = leader;
+    for (uint_t i = 0; i < PERF_COUNTERS_NUM; i++)
+    {
+        if (i != PERF_COUNTER_CYCLES)
+        {
+            group->fileDescriptors[i] = openPerfEvent((perf_counter_t)i, leader);
+        }
+    }
+
+    ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+/*
+Reads all counters of group with one read. Values are stored in order of enum "PerfCounter". Returns false if
+reading failed.
+*/
+static bool readPerfCounterGroup(
+    PerfCounterGroup *group, uint64_t values[PERF_COUNTERS_NUM], uint64_t *timeEnabled, uint64_t *timeRunning
+)
+{
+    // Layout of read_format: number of counters, time enabled, time running, values in order of opening
+    uint64_t buffer[3 + PERF_COUNTERS_NUM];
+
+    if (read(group->fileDescriptors[PERF_COUNTER_CYCLES], buffer, sizeof(buffer)) <= 0)
+    {
+        return false;
+    }
+
+    *timeEnabled = buffer[1];
+    *timeRunning = buffer[2];
+
+    // Leader is opened first, other counters follow in order of enum
+    uint_t index = 3;
+    values[PERF_COUNTER_CYCLES] = buffer[index++];
+    for (uint_t i = 0; i < PERF_COUNTERS_NUM; i++)
+    {
+        if (i != PERF_COUNTER_CYCLES)
+        {
+            values[i] = group->fileDescriptors[i] >= 0 ? buffer[index++] : 0;
+        }
+    }
+
+    return true;
+}
+
+/*
+Opens counter groups for all threads used by multithreaded sorts, which don't have them yet. Counters measure
+only the thread, which opened them, that's why they are opened on every pool thread.
+*/
+static void openPerfCounterGroups()
+{
+    uint_t numThreads = getNumThreads();
+    uint_t numGroupsOpened = perfCounterGroups.size();
+
+    if (!perfCountersSupported || numGroupsOpened >= numThreads)
+    {
+        return;
+    }
+
+    perfCounterGroups.resize(numThreads);
+    parallelFor(numThreads, [&](uint_t threadIndex) {
+        if (threadIndex >= numGroupsOpened)
+        {
+            openPerfCounterGroup(&perfCounterGroups[threadIndex]);
+        }
+    });
+
+    if (perfCounterGroups[0].fileDescriptors[PERF_COUNTER_CYCLES] < 0)
+    {
+        perfCountersSupported = false;
+        perfCounterGroups.clear();
+    }
+}
+
+/*
+Checks if counter is available on current machine.
+*/
+bool isPerfCounterAvailable(perf_counter_t counter)
+{
+    openPerfCounterGroups();
+    return perfCountersSupported && perfCounterGroups[0].fileDescriptors[counter] >= 0;
+}
+
+/*
+Starts counting of hardware performance counters on all threads used by multithreaded sorts.
+*/
+void startPerfCounters()
+{
+    openPerfCounterGroups();
+
+    for (uint_t i = 0; i < perfCounterGroups.size(); i++)
+    {
+        PerfCounterGroup *group = &perfCounterGroups[i];
+
+        if (group->fileDescriptors[PERF_COUNTER_CYCLES] >= 0)
+        {
+            readPerfCounterGroup(group, group->valuesStart, &group->timeEnabledStart, &group->timeRunningStart);
+        }
+    }
+}
+
+/*
+Stops counting and returns counter values summed over all threads since "startPerfCounters()" was called. If
+counters were multiplexed with other events, values are scaled by the fraction of time they were counting.
+*/
+void stopPerfCounters(perf_counters_t *counters)
+{
+    for (uint_t counter = 0; counter < PERF_COUNTERS_NUM; counter++)
+    {
+        counters->values[counter] = 0;
+        counters->isAvailable[counter] = perfCountersSupported && perfCounterGroups.size() > 0 &&
+            perfCounterGroups[0].fileDescriptors[counter] >= 0;
+    }
+
+    for (uint_t i = 0; i < perfCounterGroups.size(); i++)
+    {
+        PerfCounterGroup *group = &perfCounterGroups[i];
+        uint64_t values[PERF_COUNTERS_NUM];
+        uint64_t timeEnabled, timeRunning;
+
+        if (group->fileDescriptors[PERF_COUNTER_CYCLES] < 0 ||
+            !readPerfCounterGroup(group, values, &timeEnabled, &timeRunning))
+        {
+            continue;
+        }
+
+        uint64_t deltaEnabled = timeEnabled - group->timeEnabledStart;
+        uint64_t deltaRunning = timeRunning - group->timeRunningStart;
+        double scale = deltaRunning > 0 ? (double)deltaEnabled / deltaRunning : 1.0;
+
+        for (uint_t counter = 0; counter < PERF_COUNTERS_NUM; counter++)
+        {
+            counters->values[counter] += (uint64_t)((values[counter] - group->valuesStart[counter]) * scale);
+        }
+    }
+}
+
+#else
+
+/*
+Hardware performance counters are read with "perf_event_open", which is available only on Linux.
+*/
+bool isPerfCounterAvailable(perf_counter_t counter)
+{
+    return false;
+}
+
+void startPerfCounters() {}
+
+void stopPerfCounters(perf_counters_t *counters)
+{
+    for (uint_t counter = 0; counter < PERF_COUNTERS_NUM; counter++)
+    {
+        counters->values[counter] = 0;
+        counters->isAvailable[counter] = false;
+    }
+}
+
+#endif
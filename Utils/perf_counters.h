@@ -0,0 +1,38 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <stdint.h>
+
+#include "data_types_common.h"
+
+
+// Number of hardware performance counters in counter group
+#define PERF_COUNTERS_NUM 5
+
+enum PerfCounter
+{
+    PERF_COUNTER_CYCLES,
+    PERF_COUNTER_INSTRUCTIONS,
+    PERF_COUNTER_BRANCH_MISSES,
+    PERF_COUNTER_LLC_LOAD_MISSES,
+    PERF_COUNTER_DTLB_LOAD_MISSES
+};
+typedef enum PerfCounter perf_counter_t;
+
+/*
+Values of hardware performance counters measured during one sort. Counter is valid only if it is available on
+current machine (kernel, CPU and permissions).
+*/
+struct PerfCounters
+{
+    uint64_t values[PERF_COUNTERS_NUM];
+    bool isAvailable[PERF_COUNTERS_NUM];
+};
+typedef struct PerfCounters perf_counters_t;
+
+const char* getPerfCounterName(perf_counter_t counter);
+bool isPerfCounterAvailable(perf_counter_t counter);
+void startPerfCounters();
+void stopPerfCounters(perf_counters_t *counters);
+
+#endif
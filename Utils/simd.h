@@ -0,0 +1,372 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "data_types_common.h"
+
+
+/*
+Thin wrappers around vector instructions used by CPU sorts. Instruction set is chosen at compile time: AVX-512,
+AVX2 or scalar fallback (vector with one element). All comparisons are unsigned, because data type is unsigned.
+*/
+
+#if defined(__AVX512F__)
+
+#define SIMD_INSTRUCTION_SET "AVX-512"
+#define SIMD_WIDTH_BYTES 64
+typedef __m512i simd_t;
+#if DATA_TYPE_BITS == 32
+typedef __mmask16 simd_mask_t;
+#else
+typedef __mmask8 simd_mask_t;
+#endif
+
+#elif defined(__AVX2__)
+
+#define SIMD_INSTRUCTION_SET "AVX2"
+#define SIMD_WIDTH_BYTES 32
+typedef __m256i simd_t;
+typedef __m256i simd_mask_t;
+
+#else
+
+#define SIMD_INSTRUCTION_SET "scalar"
+#define SIMD_WIDTH_BYTES (DATA_TYPE_BITS / 8)
+typedef data_t simd_t;
+typedef bool simd_mask_t;
+
+#endif
+
+// Number of elements in one vector
+#define SIMD_WIDTH (SIMD_WIDTH_BYTES / (DATA_TYPE_BITS / 8))
+
+
+/*
+Loads vector from memory, which doesn't have to be aligned.
+*/
+inline simd_t simdLoad(const data_t *address)
+{
+#if defined(__AVX512F__)
+    return _mm512_loadu_si512((const void*)address);
+#elif defined(__AVX2__)
+    return _mm256_loadu_si256((const __m256i*)address);
+#else
+    return *address;
+#endif
+}
+
+/*
+Stores vector to memory, which doesn't have to be aligned.
+*/
+inline void simdStore(data_t *address, simd_t vector)
+{
+#if defined(__AVX512F__)
+    _mm512_storeu_si512((void*)address, vector);
+#elif defined(__AVX2__)
+    _mm256_storeu_si256((__m256i*)address, vector);
+#else
+    *address = vector;
+#endif
+}
+
+/*
+Returns mask of lanes, where "a > b".
+*/
+inline simd_mask_t simdGreater(simd_t a, simd_t b)
+{
+#if defined(__AVX512F__) && DATA_TYPE_BITS == 32
+    return _mm512_cmpgt_epu32_mask(a, b);
+#elif defined(__AVX512F__)
+    return _mm512_cmpgt_epu64_mask(a, b);
+#elif defined(__AVX2__) && DATA_TYPE_BITS == 32
+    // AVX2 supports only signed comparison, so sign bits are flipped
+    __m256i signBit = _mm256_set1_epi32((int)0x80000000);
+    return _mm256_cmpgt_epi32(_mm256_xor_si256(a, signBit), _mm256_xor_si256(b, signBit));
+#elif defined(__AVX2__)
+    __m256i signBit = _mm256_set1_epi64x((long long)0x8000000000000000ULL);
+    return _mm256_cmpgt_epi64(_mm256_xor_si256(a, signBit), _mm256_xor_si256(b, signBit));
+#else
+    return a > b;
+#endif
+}
+
+/*
+Takes lanes from "b", where mask is set, and lanes from "a" otherwise.
+*/
+inline simd_t simdBlend(simd_t a, simd_t b, simd_mask_t mask)
+{
+#if defined(__AVX512F__) && DATA_TYPE_BITS == 32
+    return _mm512_mask_blend_epi32(mask, a, b);
+#elif defined(__AVX512F__)
+    return _mm512_mask_blend_epi64(mask, a, b);
+#elif defined(__AVX2__)
+    return _mm256_blendv_epi8(a, b, mask);
+#else
+    return mask ? b : a;
+#endif
+}
+
+/*
+Takes mask lanes from "b", where "selector" is set, and mask lanes from "a" otherwise.
+*/
+inline simd_mask_t simdBlendMask(simd_mask_t a, simd_mask_t b, simd_mask_t selector)
+{
+#if defined(__AVX512F__)
+    return (simd_mask_t)((a & ~selector) | (b & selector));
+#elif defined(__AVX2__)
+    return _mm256_blendv_epi8(a, b, selector);
+#else
+    return selector ? b : a;
+#endif
+}
+
+/*
+Returns lane-wise minimum.
+*/
+inline simd_t simdMin(simd_t a, simd_t b)
+{
+#if defined(__AVX512F__) && DATA_TYPE_BITS == 32
+    return _mm512_min_epu32(a, b);
+#elif defined(__AVX512F__)
+    return _mm512_min_epu64(a, b);
+#elif defined(__AVX2__) && DATA_TYPE_BITS == 32
+    return _mm256_min_epu32(a, b);
+#else
+    return simdBlend(a, b, simdGreater(a, b));
+#endif
+}
+
+/*
+Returns lane-wise maximum.
+*/
+inline simd_t simdMax(simd_t a, simd_t b)
+{
+#if defined(__AVX512F__) && DATA_TYPE_BITS == 32
+    return _mm512_max_epu32(a, b);
+#elif defined(__AVX512F__)
+    return _mm512_max_epu64(a, b);
+#elif defined(__AVX2__) && DATA_TYPE_BITS == 32
+    return _mm256_max_epu32(a, b);
+#else
+    return simdBlend(b, a, simdGreater(a, b));
+#endif
+}
+
+/*
+Creates permutation, which can be passed to "simdPermute". Lane "i" of permuted vector is taken from lane
+"laneIndexes[i]".
+*/
+inline simd_t simdPermutation(const uint_t *laneIndexes)
+{
+#if defined(__AVX512F__) && DATA_TYPE_BITS == 32
+    return _mm512_loadu_si512((const void*)laneIndexes);
+#elif defined(__AVX512F__)
+    uint64_t indexes[SIMD_WIDTH];
+    for (uint_t i = 0; i < SIMD_WIDTH; i++)
+    {
+        indexes[i] = laneIndexes[i];
+    }
+    return _mm512_loadu_si512((const void*)indexes);
+#elif defined(__AVX2__) && DATA_TYPE_BITS == 32
+    return _mm256_loadu_si256((const __m256i*)laneIndexes);
+#elif defined(__AVX2__)
+    // 64-bit lanes are permuted as pairs of 32-bit lanes
+    uint32_t indexes[2 * SIMD_WIDTH];
+    for (uint_t i = 0; i < SIMD_WIDTH; i++)
+    {
+        indexes[2 * i] = 2 * laneIndexes[i];
+        indexes[2 * i + 1] = 2 * laneIndexes[i] + 1;
+    }
+    return _mm256_loadu_si256((const __m256i*)indexes);
+#else
+    return 0;
+#endif
+}
+
+/*
+Permutes lanes of vector with permutation created by "simdPermutation".
+*/
+inline simd_t simdPermute(simd_t vector, simd_t permutation)
+{
+#if defined(__AVX512F__) && DATA_TYPE_BITS == 32
+    return _mm512_permutexvar_epi32(permutation, vector);
+#elif defined(__AVX512F__)
+    return _mm512_permutexvar_epi64(permutation, vector);
+#elif defined(__AVX2__)
+    return _mm256_permutevar8x32_epi32(vector, permutation);
+#else
+    return vector;
+#endif
+}
+
+/*
+Creates mask, which is set in lanes, where "laneFlags[i]" is not 0.
+*/
+inline simd_mask_t simdLaneMask(const uint_t *laneFlags)
+{
+    data_t flags[SIMD_WIDTH];
+    data_t zeros[SIMD_WIDTH];
+
+    for (uint_t i = 0; i < SIMD_WIDTH; i++)
+    {
+        flags[i] = laneFlags[i] != 0;
+        zeros[i] = 0;
+    }
+
+    return simdGreater(simdLoad(flags), simdLoad(zeros));
+}
+
+/*
+Creates vector with all lanes set to "value".
+*/
+inline simd_t simdSet(data_t value)
+{
+#if defined(__AVX512F__) && DATA_TYPE_BITS == 32
+    return _mm512_set1_epi32((int)value);
+#elif defined(__AVX512F__)
+    return _mm512_set1_epi64((long long)value);
+#elif defined(__AVX2__) && DATA_TYPE_BITS == 32
+    return _mm256_set1_epi32((int)value);
+#elif defined(__AVX2__)
+    return _mm256_set1_epi64x((long long)value);
+#else
+    return value;
+#endif
+}
+
+/*
+Returns lane-wise sum (modulo lane width).
+*/
+inline simd_t simdAdd(simd_t a, simd_t b)
+{
+#if defined(__AVX512F__) && DATA_TYPE_BITS == 32
+    return _mm512_add_epi32(a, b);
+#elif defined(__AVX512F__)
+    return _mm512_add_epi64(a, b);
+#elif defined(__AVX2__) && DATA_TYPE_BITS == 32
+    return _mm256_add_epi32(a, b);
+#elif defined(__AVX2__)
+    return _mm256_add_epi64(a, b);
+#else
+    return a + b;
+#endif
+}
+
+/*
+Returns lane-wise product (lower half of result).
+*/
+inline simd_t simdMultiply(simd_t a, simd_t b)
+{
+#if defined(__AVX512F__) && DATA_TYPE_BITS == 32
+    return _mm512_mullo_epi32(a, b);
+#elif defined(__AVX512F__)
+    return _mm512_mullox_epi64(a, b);
+#elif defined(__AVX2__) && DATA_TYPE_BITS == 32
+    return _mm256_mullo_epi32(a, b);
+#elif defined(__AVX2__)
+    // AVX2 doesn't support 64-bit multiplication, so it is composed from 32-bit multiplications
+    __m256i lowLow = _mm256_mul_epu32(a, b);
+    __m256i lowHigh = _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32));
+    __m256i highLow = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), b);
+    return _mm256_add_epi64(lowLow, _mm256_slli_epi64(_mm256_add_epi64(lowHigh, highLow), 32));
+#else
+    return a * b;
+#endif
+}
+
+/*
+Returns lane-wise bitwise XOR.
+*/
+inline simd_t simdXor(simd_t a, simd_t b)
+{
+#if defined(__AVX512F__)
+    return _mm512_xor_si512(a, b);
+#elif defined(__AVX2__)
+    return _mm256_xor_si256(a, b);
+#else
+    return a ^ b;
+#endif
+}
+
+/*
+Shifts all lanes right by "shift" bits (logical shift).
+*/
+inline simd_t simdShiftRight(simd_t a, uint_t shift)
+{
+#if defined(__AVX512F__) && DATA_TYPE_BITS == 32
+    return _mm512_srli_epi32(a, shift);
+#elif defined(__AVX512F__)
+    return _mm512_srli_epi64(a, shift);
+#elif defined(__AVX2__) && DATA_TYPE_BITS == 32
+    return _mm256_srli_epi32(a, shift);
+#elif defined(__AVX2__)
+    return _mm256_srli_epi64(a, shift);
+#else
+    return a >> shift;
+#endif
+}
+
+/*
+Returns mask of lanes, where "a == b".
+*/
+inline simd_mask_t simdEqual(simd_t a, simd_t b)
+{
+#if defined(__AVX512F__) && DATA_TYPE_BITS == 32
+    return _mm512_cmpeq_epu32_mask(a, b);
+#elif defined(__AVX512F__)
+    return _mm512_cmpeq_epu64_mask(a, b);
+#elif defined(__AVX2__) && DATA_TYPE_BITS == 32
+    return _mm256_cmpeq_epi32(a, b);
+#elif defined(__AVX2__)
+    return _mm256_cmpeq_epi64(a, b);
+#else
+    return a == b;
+#endif
+}
+
+/*
+Returns mask of lanes, which are set in both masks.
+*/
+inline simd_mask_t simdMaskAnd(simd_mask_t a, simd_mask_t b)
+{
+#if defined(__AVX512F__)
+    return (simd_mask_t)(a & b);
+#elif defined(__AVX2__)
+    return _mm256_and_si256(a, b);
+#else
+    return a && b;
+#endif
+}
+
+/*
+Returns mask of lanes, which are set in at least one of masks.
+*/
+inline simd_mask_t simdMaskOr(simd_mask_t a, simd_mask_t b)
+{
+#if defined(__AVX512F__)
+    return (simd_mask_t)(a | b);
+#elif defined(__AVX2__)
+    return _mm256_or_si256(a, b);
+#else
+    return a || b;
+#endif
+}
+
+/*
+Returns true, if any lane of mask is set.
+*/
+inline bool simdMaskAny(simd_mask_t mask)
+{
+#if defined(__AVX512F__)
+    return mask != 0;
+#elif defined(__AVX2__)
+    return !_mm256_testz_si256(mask, mask);
+#else
+    return mask;
+#endif
+}
+
+#endif
@@ -62,7 +62,10 @@ void quickSort(T *dataTable, uint_t tableLen, order_t sortOrder)
     }
 }
 
+// For 32-bit keys "data_t" is the same type as "uint_t"
+#if DATA_TYPE_BITS != 32
 template void quickSort<data_t>(data_t *dataTable, uint_t tableLen, order_t sortOrder);
+#endif
 template void quickSort<uint_t>(uint_t *dataTable, uint_t tableLen, order_t sortOrder);
 template void quickSort<int_t>(int_t *dataTable, uint_t tableLen, order_t sortOrder);
 
@@ -87,7 +90,10 @@ void stdVectorSort(T *dataTable, uint_t tableLen, order_t sortOrder)
     std::copy(dataVector.begin(), dataVector.end(), dataTable);
 }
 
+// For 32-bit keys "data_t" is the same type as "uint_t"
+#if DATA_TYPE_BITS != 32
 template void stdVectorSort<data_t>(data_t *dataTable, uint_t tableLen, order_t sortOrder);
+#endif
 template void stdVectorSort<uint_t>(uint_t *dataTable, uint_t tableLen, order_t sortOrder);
 template void stdVectorSort<int_t>(int_t *dataTable, uint_t tableLen, order_t sortOrder);
 
@@ -98,7 +104,7 @@ sorts.
 */
 double sortCorrect(data_t *dataTable, uint_t tableLen, order_t sortOrder)
 {
-    LARGE_INTEGER timer;
+    stopwatch_t timer;
     startStopwatch(&timer);
 
     // C++ std vector sort is faster than C++ Quicksort. But vector sort throws exception, if too much memory
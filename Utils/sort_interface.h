@@ -5,13 +5,11 @@
 #include <stdio.h>
 #include <string>
 
-#include <cuda.h>
-#include "cuda_runtime.h"
-#include "device_launch_parameters.h"
-
 #include "data_types_common.h"
 #include "host.h"
-#include "cuda.h"
+#include "cache.h"
+#include "perf_counters.h"
+#include "trace.h"
 
 
 /*
@@ -36,6 +34,10 @@ protected:
     double _sortTime = -1;
     // Denotes if sort timing should be executed
     bool _stopwatchEnabled = false;
+    // Hardware performance counters measured during sort
+    perf_counters_t _perfCounters;
+    // Denotes if hardware performance counters should be measured
+    bool _perfCountersEnabled = false;
 
     /*
     Executes the sort.
@@ -63,7 +65,8 @@ protected:
     }
 
     /*
-    Method for allocating memory needed both for key only and key-value sort.
+    Method for allocating memory needed both for key only and key-value sort. Memory has to be allocated with
+    "trackedMalloc" (or "trackedNew"), so it is included in allocation statistics of sort.
     */
     virtual void memoryAllocate(data_t *h_keys, data_t *h_values, uint_t arrayLength) {}
 
@@ -77,8 +80,88 @@ protected:
     */
     virtual void memoryCopyAfterSort(data_t *h_keys, data_t *h_values, uint_t arrayLength) {}
 
+    /*
+    Waits for all operations of the sort to complete. Needed for timing of sorts, which are executed
+    asynchronously.
+    */
+    virtual void synchronize() {}
+
+    /*
+    Returns the number of bytes read and written by sort, if keys are passed over "keyPasses" times and values
+    "valuePasses" times (one pass reads or writes whole array). Values are counted only in key-value sort.
+    */
+    double getBytesOfPasses(double keyPasses, double valuePasses)
+    {
+        double bytes = keyPasses * _arrayLength * sizeof(*_h_keys);
+
+        if (_h_values != NULL)
+        {
+            bytes += valuePasses * _arrayLength * sizeof(*_h_values);
+        }
+
+        return bytes;
+    }
+
+    /*
+    Returns the number of bytes of keys and values of one element. Values are counted only in key-value sort.
+    */
+    double getElementSize()
+    {
+        return sizeof(*_h_keys) + (_h_values != NULL ? sizeof(*_h_values) : 0);
+    }
+
+    /*
+    Returns the number of levels of sort, which are executed from main memory. Sort executes "numLevels" levels and
+    on every level its subarrays are "splitFactor" times shorter than on previous level (1, if every level passes
+    over whole array). Level is executed from main memory, while its subarrays don't fit into last level cache
+    together with all auxiliary arrays ("bytesPerElement" contains bytes of all arrays accessed per element).
+    */
+    double getNumMemoryLevels(double numLevels, double splitFactor, double bytesPerElement)
+    {
+        double cacheSize = (double)getLastLevelCacheSize();
+        double subarrayLength = _arrayLength;
+        double level = 0;
+
+        for (; level < numLevels && subarrayLength * bytesPerElement > cacheSize; level++)
+        {
+            subarrayLength /= splitFactor;
+        }
+
+        return level < numLevels ? level : numLevels;
+    }
+
+    /*
+    Returns the number of bytes read and written by levels of sort, which are executed in last level cache. They
+    read keys and values from main memory once, when subarrays are loaded into cache, and write them back once.
+    Returns 0, if all "numLevels" levels are executed from main memory.
+    */
+    double getBytesOfCacheLevels(double numLevels, double numMemoryLevels)
+    {
+        return numMemoryLevels < numLevels ? getBytesOfPasses(2, 2) : 0;
+    }
+
+    /*
+    Returns the number of distribution levels of sample sort, if array is always distributed into "numBuckets"
+    buckets of equal size, until buckets contain at most "smallSortThreshold" elements. Length of buckets on the
+    last level is returned in "bucketLength".
+    */
+    uint_t getNumDistributionLevels(
+        uint_t arrayLength, uint_t numBuckets, uint_t smallSortThreshold, double *bucketLength
+    )
+    {
+        uint_t numLevels = 0;
+        *bucketLength = arrayLength;
+
+        for (; *bucketLength > smallSortThreshold; numLevels++)
+        {
+            *bucketLength /= numBuckets;
+        }
+
+        return numLevels;
+    }
+
 public:
-    ~SortSequential()
+    virtual ~SortSequential()
     {
         memoryDestroy();
     }
@@ -113,6 +196,21 @@ public:
         _stopwatchEnabled = false;
     }
 
+    void perfCountersEnable()
+    {
+        _perfCountersEnabled = true;
+    }
+
+    void perfCountersDisable()
+    {
+        _perfCountersEnabled = false;
+    }
+
+    bool isPerfCountersEnabled()
+    {
+        return _perfCountersEnabled;
+    }
+
     double getSortTime()
     {
         if (!_stopwatchEnabled)
@@ -136,6 +234,32 @@ public:
         return _sortTime;
     }
 
+    /*
+    Returns hardware performance counters of the last sort. Counters, which couldn't be measured, are marked as
+    unavailable.
+    */
+    perf_counters_t getPerfCounters()
+    {
+        if (!_perfCountersEnabled)
+        {
+            printf("Performance counters have to be explicitly enabled with method: perfCountersEnable().\n");
+            exit(EXIT_FAILURE);
+        }
+
+        return _perfCounters;
+    }
+
+    /*
+    Returns the model of main memory traffic of the last sort in bytes. Passes over subarrays, which don't fit into
+    last level cache, are counted fully. Passes over subarrays, which fit into it, are counted only once, when
+    subarrays are loaded into cache and written back. Together with sort time it gives achieved memory bandwidth.
+    Returns 0, if sort doesn't have a model.
+    */
+    virtual double getBytesMoved()
+    {
+        return 0;
+    }
+
     /*
     Method for destroying memory needed for sort. For sort testing purposes this method is public.
     */
@@ -149,40 +273,48 @@ public:
     */
     virtual void sort(data_t *h_keys, uint_t arrayLength, order_t sortOrder)
     {
-        cudaError_t error;
-
+        // Memory allocated for shorter array is released before memory for longer array is allocated
         if (arrayLength > _arrayLength)
         {
+            memoryDestroy();
             memoryAllocate(h_keys, NULL, arrayLength);
         }
 
         setPrivateVars(h_keys, NULL, arrayLength, sortOrder);
         memoryCopyBeforeSort(h_keys, NULL, arrayLength);
 
-        LARGE_INTEGER timer;
-        if (_stopwatchEnabled)
+        if (_stopwatchEnabled || _perfCountersEnabled)
+        {
+            synchronize();
+        }
+        if (_perfCountersEnabled)
         {
-            if (isSortParallel())
-            {
-                error = cudaDeviceSynchronize();
-                checkCudaError(error);
-            }
+            startPerfCounters();
+        }
 
+        stopwatch_t timer;
+        if (_stopwatchEnabled)
+        {
             startStopwatch(&timer);
         }
 
-        sortKeyOnly();
+        {
+            TRACE_SCOPE("sort");
+            sortKeyOnly();
+        }
 
+        if (_stopwatchEnabled || _perfCountersEnabled)
+        {
+            synchronize();
+        }
         if (_stopwatchEnabled)
         {
-            if (isSortParallel())
-            {
-                error = cudaDeviceSynchronize();
-                checkCudaError(error);
-            }
-
             _sortTime = endStopwatch(timer);
         }
+        if (_perfCountersEnabled)
+        {
+            stopPerfCounters(&_perfCounters);
+        }
 
         memoryCopyAfterSort(h_keys, NULL, arrayLength);
     }
@@ -192,150 +324,50 @@ public:
     */
     virtual void sort(data_t *h_keys, data_t *h_values, uint_t arrayLength, order_t sortOrder)
     {
-        cudaError_t error;
-
+        // Memory allocated for shorter array is released before memory for longer array is allocated
         if (arrayLength > _arrayLength)
         {
+            memoryDestroy();
             memoryAllocate(h_keys, h_values, arrayLength);
         }
 
         setPrivateVars(h_keys, h_values, arrayLength, sortOrder);
         memoryCopyBeforeSort(h_keys, h_values, arrayLength);
 
-        LARGE_INTEGER timer;
-        if (_stopwatchEnabled)
+        if (_stopwatchEnabled || _perfCountersEnabled)
         {
-            if (isSortParallel())
-            {
-                error = cudaDeviceSynchronize();
-                checkCudaError(error);
-            }
-
-            startStopwatch(&timer);
+            synchronize();
+        }
+        if (_perfCountersEnabled)
+        {
+            startPerfCounters();
         }
 
-        sortKeyValue();
-
+        stopwatch_t timer;
         if (_stopwatchEnabled)
         {
-            if (isSortParallel())
-            {
-                error = cudaDeviceSynchronize();
-                checkCudaError(error);
-            }
-
-            _sortTime = endStopwatch(timer);
+            startStopwatch(&timer);
         }
 
-        memoryCopyAfterSort(h_keys, h_values, arrayLength);
-    }
-};
-
-
-/*
-Base class for parallel sort of key-value pairs.
-*/
-class SortParallel : public SortSequential
-{
-protected:
-    // Array for keys on device
-    data_t *_d_keys = NULL;
-    // Array for values on device
-    data_t *_d_values = NULL;
-    // Denotes if sort is sequential or parallel
-    bool _isSortParallel = true;
-
-    /*
-    Method for allocating memory needed both for key only and key-value sort.
-    */
-    virtual void memoryAllocate(data_t *h_keys, data_t *h_values, uint_t arrayLength)
-    {
-        cudaError_t error;
-        SortSequential::memoryAllocate(h_keys, h_values, arrayLength);
-
-        // Allocates keys and values
-        error = cudaMalloc((void **)&_d_keys, arrayLength * sizeof(*_d_keys));
-        checkCudaError(error);
-        error = cudaMalloc((void **)&_d_values, arrayLength * sizeof(*_d_values));
-        checkCudaError(error);
-    }
-
-    /*
-    Memory copy operations needed before sort. If sorting keys only, than "h_values" contains NULL.
-    */
-    virtual void memoryCopyBeforeSort(data_t *h_keys, data_t *h_values, uint_t arrayLength)
-    {
-        cudaError_t error;
-        SortSequential::memoryCopyBeforeSort(h_keys, h_values, arrayLength);
-
-        // Copies keys
-        error = cudaMemcpy(
-            (void *)_d_keys, h_keys, arrayLength * sizeof(*h_keys), cudaMemcpyHostToDevice
-        );
-        checkCudaError(error);
-
-        if (h_values == NULL)
         {
-            return;
+            TRACE_SCOPE("sort");
+            sortKeyValue();
         }
 
-        // Copies values
-        error = cudaMemcpy(
-            (void *)_d_values, h_values, arrayLength * sizeof(*_d_values), cudaMemcpyHostToDevice
-        );
-        checkCudaError(error);
-    }
-
-    /*
-    Copies data from device to host. If sorting keys only, than "h_values" contains NULL.
-    */
-    virtual void memoryCopyAfterSort(data_t *h_keys, data_t *h_values, uint_t arrayLength)
-    {
-        cudaError_t error;
-        SortSequential::memoryCopyAfterSort(h_keys, h_values, arrayLength);
-
-        // Copies keys
-        error = cudaMemcpy(
-            h_keys, (void *)_d_keys, _arrayLength * sizeof(*_h_keys), cudaMemcpyDeviceToHost
-        );
-        checkCudaError(error);
-
-        if (h_values == NULL)
+        if (_stopwatchEnabled || _perfCountersEnabled)
         {
-            return;
+            synchronize();
         }
-
-        // Copies values
-        error = cudaMemcpy(
-            h_values, (void *)_d_values, arrayLength * sizeof(*h_values), cudaMemcpyDeviceToHost
-        );
-        checkCudaError(error);
-    }
-
-public:
-    bool isSortParallel()
-    {
-        return _isSortParallel;
-    }
-
-    /*
-    Method for destroying memory needed for sort. For sort testing purposes this method is public.
-    */
-    virtual void memoryDestroy()
-    {
-        if (_arrayLength == 0)
+        if (_stopwatchEnabled)
+        {
+            _sortTime = endStopwatch(timer);
+        }
+        if (_perfCountersEnabled)
         {
-            return;
+            stopPerfCounters(&_perfCounters);
         }
 
-        cudaError_t error;
-        SortSequential::memoryDestroy();
-
-        // Destroys keys and values
-        error = cudaFree(_d_keys);
-        checkCudaError(error);
-        error = cudaFree(_d_values);
-        checkCudaError(error);
+        memoryCopyAfterSort(h_keys, h_values, arrayLength);
     }
 };
 
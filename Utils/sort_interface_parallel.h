@@ -0,0 +1,129 @@
+#ifndef SORT_INTERFACE_PARALLEL_H
+#define SORT_INTERFACE_PARALLEL_H
+
+#include <cuda.h>
+#include "cuda_runtime.h"
+#include "device_launch_parameters.h"
+
+#include "data_types_common.h"
+#include "sort_interface.h"
+#include "cuda.h"
+
+
+/*
+Base class for parallel sort of key-value pairs.
+*/
+class SortParallel : public SortSequential
+{
+protected:
+    // Array for keys on device
+    data_t *_d_keys = NULL;
+    // Array for values on device
+    data_t *_d_values = NULL;
+    // Denotes if sort is sequential or parallel
+    bool _isSortParallel = true;
+
+    /*
+    Method for allocating memory needed both for key only and key-value sort.
+    */
+    virtual void memoryAllocate(data_t *h_keys, data_t *h_values, uint_t arrayLength)
+    {
+        cudaError_t error;
+        SortSequential::memoryAllocate(h_keys, h_values, arrayLength);
+
+        // Allocates keys and values
+        error = cudaMalloc((void **)&_d_keys, arrayLength * sizeof(*_d_keys));
+        checkCudaError(error);
+        error = cudaMalloc((void **)&_d_values, arrayLength * sizeof(*_d_values));
+        checkCudaError(error);
+    }
+
+    /*
+    Memory copy operations needed before sort. If sorting keys only, than "h_values" contains NULL.
+    */
+    virtual void memoryCopyBeforeSort(data_t *h_keys, data_t *h_values, uint_t arrayLength)
+    {
+        cudaError_t error;
+        SortSequential::memoryCopyBeforeSort(h_keys, h_values, arrayLength);
+
+        // Copies keys
+        error = cudaMemcpy(
+            (void *)_d_keys, h_keys, arrayLength * sizeof(*h_keys), cudaMemcpyHostToDevice
+        );
+        checkCudaError(error);
+
+        if (h_values == NULL)
+        {
+            return;
+        }
+
+        // Copies values
+        error = cudaMemcpy(
+            (void *)_d_values, h_values, arrayLength * sizeof(*_d_values), cudaMemcpyHostToDevice
+        );
+        checkCudaError(error);
+    }
+
+    /*
+    Waits for device to complete all operations.
+    */
+    virtual void synchronize()
+    {
+        cudaError_t error = cudaDeviceSynchronize();
+        checkCudaError(error);
+    }
+
+    /*
+    Copies data from device to host. If sorting keys only, than "h_values" contains NULL.
+    */
+    virtual void memoryCopyAfterSort(data_t *h_keys, data_t *h_values, uint_t arrayLength)
+    {
+        cudaError_t error;
+        SortSequential::memoryCopyAfterSort(h_keys, h_values, arrayLength);
+
+        // Copies keys
+        error = cudaMemcpy(
+            h_keys, (void *)_d_keys, _arrayLength * sizeof(*_h_keys), cudaMemcpyDeviceToHost
+        );
+        checkCudaError(error);
+
+        if (h_values == NULL)
+        {
+            return;
+        }
+
+        // Copies values
+        error = cudaMemcpy(
+            h_values, (void *)_d_values, arrayLength * sizeof(*h_values), cudaMemcpyDeviceToHost
+        );
+        checkCudaError(error);
+    }
+
+public:
+    bool isSortParallel()
+    {
+        return _isSortParallel;
+    }
+
+    /*
+    Method for destroying memory needed for sort. For sort testing purposes this method is public.
+    */
+    virtual void memoryDestroy()
+    {
+        if (_arrayLength == 0)
+        {
+            return;
+        }
+
+        cudaError_t error;
+        SortSequential::memoryDestroy();
+
+        // Destroys keys and values
+        error = cudaFree(_d_keys);
+        checkCudaError(error);
+        error = cudaFree(_d_values);
+        checkCudaError(error);
+    }
+};
+
+#endif
@@ -0,0 +1,250 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "data_types_common.h"
+#include "simd.h"
+#include "threads.h"
+#include "sort_verify.h"
+
+
+// Constants of mixing functions used for fingerprint hashes. Multipliers are odd, so hashes are bijective.
+#if DATA_TYPE_BITS == 32
+#define HASH_FIRST_MULTIPLIER_1 0x7FEB352DU
+#define HASH_FIRST_MULTIPLIER_2 0x846CA68BU
+#define HASH_SECOND_MULTIPLIER_1 0x21F0AAADU
+#define HASH_SECOND_MULTIPLIER_2 0x735A2D97U
+#define HASH_SHIFT_1 16
+#define HASH_SHIFT_2 15
+#define HASH_SHIFT_3 16
+#else
+#define HASH_FIRST_MULTIPLIER_1 0xBF58476D1CE4E5B9ULL
+#define HASH_FIRST_MULTIPLIER_2 0x94D049BB133111EBULL
+#define HASH_SECOND_MULTIPLIER_1 0xFF51AFD7ED558CCDULL
+#define HASH_SECOND_MULTIPLIER_2 0xC4CEB9FE1A85EC53ULL
+#define HASH_SHIFT_1 30
+#define HASH_SHIFT_2 27
+#define HASH_SHIFT_3 31
+#endif
+
+
+/*
+Lane-wise mixing function (xor-shift-multiply), which is used for fingerprint hashes.
+*/
+inline simd_t mixHash(simd_t x, data_t multiplier1, data_t multiplier2)
+{
+    x = simdXor(x, simdShiftRight(x, HASH_SHIFT_1));
+    x = simdMultiply(x, simdSet(multiplier1));
+    x = simdXor(x, simdShiftRight(x, HASH_SHIFT_2));
+    x = simdMultiply(x, simdSet(multiplier2));
+    return simdXor(x, simdShiftRight(x, HASH_SHIFT_3));
+}
+
+/*
+Adds hashes of keys (or key-value pairs) to fingerprint sums. Key and value are combined differently for every
+hash, so the pair is bound together (swapped values between different keys change the fingerprint).
+*/
+template <bool sortingKeyOnly>
+inline void addToFingerprint(simd_t keys, simd_t values, simd_t &sumFirst, simd_t &sumSecond)
+{
+    simd_t first = keys, second = keys;
+
+    if (!sortingKeyOnly)
+    {
+        first = simdXor(keys, mixHash(values, HASH_SECOND_MULTIPLIER_1, HASH_SECOND_MULTIPLIER_2));
+        second = simdAdd(keys, mixHash(values, HASH_FIRST_MULTIPLIER_1, HASH_FIRST_MULTIPLIER_2));
+    }
+
+    sumFirst = simdAdd(sumFirst, mixHash(first, HASH_FIRST_MULTIPLIER_1, HASH_FIRST_MULTIPLIER_2));
+    sumSecond = simdAdd(sumSecond, mixHash(second, HASH_SECOND_MULTIPLIER_1, HASH_SECOND_MULTIPLIER_2));
+}
+
+/*
+Returns the sum of first "numLanes" lanes of vector.
+*/
+inline data_t sumLanes(simd_t vector, uint_t numLanes)
+{
+    data_t lanes[SIMD_WIDTH];
+    data_t sum = 0;
+    simdStore(lanes, vector);
+
+    for (uint_t i = 0; i < numLanes; i++)
+    {
+        sum += lanes[i];
+    }
+
+    return sum;
+}
+
+/*
+Computes fingerprint of chunk [chunkStart, chunkEnd). If "checkOrder" is set, it also checks if every element in
+chunk is ordered correctly in relation to its successor (which can be located in the next chunk) and if equal
+keys are ordered by values (which are expected to be initial indexes of elements).
+*/
+template <bool sortingKeyOnly>
+void verifyChunk(
+    data_t *keys, data_t *values, uint_t arrayLength, uint_t chunkStart, uint_t chunkEnd, order_t sortOrder,
+    bool checkOrder, fingerprint_t *fingerprint, bool *isSorted, bool *isStable
+)
+{
+    simd_t sumFirst = simdSet(0), sumSecond = simdSet(0), valuesVector = simdSet(0);
+    // Masks with no lanes set
+    simd_mask_t orderViolations = simdGreater(sumFirst, sumFirst);
+    simd_mask_t stabilityViolations = orderViolations;
+    uint_t i = chunkStart;
+
+    // Vector "i + 1" can be loaded only, if it doesn't exceed the end of array
+    for (; i + SIMD_WIDTH <= chunkEnd && i + SIMD_WIDTH < arrayLength; i += SIMD_WIDTH)
+    {
+        simd_t keysVector = simdLoad(keys + i);
+        if (!sortingKeyOnly)
+        {
+            valuesVector = simdLoad(values + i);
+        }
+        addToFingerprint<sortingKeyOnly>(keysVector, valuesVector, sumFirst, sumSecond);
+
+        if (!checkOrder)
+        {
+            continue;
+        }
+
+        simd_t keysNext = simdLoad(keys + i + 1);
+        simd_mask_t isGreater = sortOrder == ORDER_ASC ? simdGreater(keysVector, keysNext) : simdGreater(
+            keysNext, keysVector
+        );
+        orderViolations = simdMaskOr(orderViolations, isGreater);
+
+        if (!sortingKeyOnly)
+        {
+            simd_mask_t isUnstable = simdMaskAnd(
+                simdEqual(keysVector, keysNext), simdGreater(valuesVector, simdLoad(values + i + 1))
+            );
+            stabilityViolations = simdMaskOr(stabilityViolations, isUnstable);
+        }
+    }
+
+    fingerprint->sumFirst = sumLanes(sumFirst, SIMD_WIDTH);
+    fingerprint->sumSecond = sumLanes(sumSecond, SIMD_WIDTH);
+    *isSorted = !simdMaskAny(orderViolations);
+    *isStable = !simdMaskAny(stabilityViolations);
+
+    // Remaining elements are copied to buffer, so they can be hashed with the same function
+    for (; i < chunkEnd; i += SIMD_WIDTH)
+    {
+        data_t keysBuffer[SIMD_WIDTH] = { 0 }, valuesBuffer[SIMD_WIDTH] = { 0 };
+        uint_t numElements = chunkEnd - i < SIMD_WIDTH ? chunkEnd - i : SIMD_WIDTH;
+
+        for (uint_t j = 0; j < numElements; j++)
+        {
+            keysBuffer[j] = keys[i + j];
+            valuesBuffer[j] = sortingKeyOnly ? 0 : values[i + j];
+
+            if (!checkOrder || i + j + 1 >= arrayLength)
+            {
+                continue;
+            }
+
+            data_t key = keys[i + j], keyNext = keys[i + j + 1];
+            *isSorted = *isSorted && (sortOrder == ORDER_ASC ? key <= keyNext : key >= keyNext);
+            *isStable = *isStable && (sortingKeyOnly || key != keyNext || values[i + j] <= values[i + j + 1]);
+        }
+
+        simd_t sumFirstTail = simdSet(0), sumSecondTail = simdSet(0);
+        addToFingerprint<sortingKeyOnly>(
+            simdLoad(keysBuffer), simdLoad(valuesBuffer), sumFirstTail, sumSecondTail
+        );
+        fingerprint->sumFirst += sumLanes(sumFirstTail, numElements);
+        fingerprint->sumSecond += sumLanes(sumSecondTail, numElements);
+    }
+}
+
+/*
+Computes fingerprint of the whole array in parallel and optionally checks order and stability. Array is divided
+into equal chunks, one for every thread.
+*/
+template <bool sortingKeyOnly>
+void verifyArray(
+    data_t *keys, data_t *values, uint_t arrayLength, order_t sortOrder, bool checkOrder,
+    fingerprint_t *fingerprint, bool *isSorted, bool *isStable
+)
+{
+    uint_t numThreads = getNumThreads();
+    std::vector<fingerprint_t> fingerprints(numThreads);
+    // "std::vector<bool>" can't be written by multiple threads
+    std::vector<uint8_t> sorted(numThreads), stable(numThreads);
+
+    parallelFor(numThreads, [&](uint_t threadIndex) {
+        uint_t chunkStart = (uint_t)((uint64_t)arrayLength * threadIndex / numThreads);
+        uint_t chunkEnd = (uint_t)((uint64_t)arrayLength * (threadIndex + 1) / numThreads);
+        bool isChunkSorted, isChunkStable;
+
+        verifyChunk<sortingKeyOnly>(
+            keys, values, arrayLength, chunkStart, chunkEnd, sortOrder, checkOrder, &fingerprints[threadIndex],
+            &isChunkSorted, &isChunkStable
+        );
+
+        sorted[threadIndex] = isChunkSorted;
+        stable[threadIndex] = isChunkStable;
+    });
+
+    fingerprint->sumFirst = 0;
+    fingerprint->sumSecond = 0;
+    *isSorted = true;
+    *isStable = true;
+
+    for (uint_t i = 0; i < numThreads; i++)
+    {
+        fingerprint->sumFirst += fingerprints[i].sumFirst;
+        fingerprint->sumSecond += fingerprints[i].sumSecond;
+        *isSorted = *isSorted && sorted[i];
+        *isStable = *isStable && stable[i];
+    }
+}
+
+/*
+Computes order-independent fingerprint of keys. If values aren't NULL, fingerprint of key-value pairs is computed.
+*/
+fingerprint_t computeFingerprint(data_t *keys, data_t *values, uint_t arrayLength)
+{
+    fingerprint_t fingerprint;
+    bool isSorted, isStable;
+
+    if (values == NULL)
+    {
+        verifyArray<true>(keys, values, arrayLength, ORDER_ASC, false, &fingerprint, &isSorted, &isStable);
+    }
+    else
+    {
+        verifyArray<false>(keys, values, arrayLength, ORDER_ASC, false, &fingerprint, &isSorted, &isStable);
+    }
+
+    return fingerprint;
+}
+
+/*
+Verifies sorted array in a single linear pass without reference sort. Sort is correct, if keys are ordered and
+fingerprint of output equals fingerprint of input. For key-value sort the fingerprint also covers values, so
+values have to remain paired with their keys and have to be unique (every input value has to appear exactly once).
+Sort is stable, if equal keys are ordered by values, which have to be initial indexes of elements. If values are
+NULL, only keys are verified.
+*/
+void verifySort(
+    data_t *keys, data_t *values, uint_t arrayLength, order_t sortOrder, fingerprint_t inputFingerprint,
+    bool *isCorrect, bool *isStable
+)
+{
+    fingerprint_t fingerprint;
+    bool isSorted;
+
+    if (values == NULL)
+    {
+        verifyArray<true>(keys, values, arrayLength, sortOrder, true, &fingerprint, &isSorted, isStable);
+    }
+    else
+    {
+        verifyArray<false>(keys, values, arrayLength, sortOrder, true, &fingerprint, &isSorted, isStable);
+    }
+
+    *isCorrect = isSorted && fingerprint.sumFirst == inputFingerprint.sumFirst &&
+        fingerprint.sumSecond == inputFingerprint.sumSecond;
+}
@@ -0,0 +1,25 @@
+#ifndef SORT_VERIFY_H
+#define SORT_VERIFY_H
+
+#include "data_types_common.h"
+
+
+typedef struct Fingerprint fingerprint_t;
+
+/*
+Order-independent fingerprint of multiset of keys (or key-value pairs). It consists of sums of two independent
+hashes, so the probability that two different multisets have the same fingerprint is negligible.
+*/
+struct Fingerprint
+{
+    data_t sumFirst;
+    data_t sumSecond;
+};
+
+fingerprint_t computeFingerprint(data_t *keys, data_t *values, uint_t arrayLength);
+void verifySort(
+    data_t *keys, data_t *values, uint_t arrayLength, order_t sortOrder, fingerprint_t inputFingerprint,
+    bool *isCorrect, bool *isStable
+);
+
+#endif
@@ -0,0 +1,165 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <math.h>
+#include <vector>
+#include <random>
+#include <utility>
+#include <algorithm>
+
+#include "data_types_common.h"
+#include "statistics.h"
+
+
+/*
+Returns percentile (between 0 and 1) of sorted samples. Values between samples are linearly interpolated.
+*/
+static double percentileSorted(std::vector<double> &samples, double percentile)
+{
+    if (samples.empty())
+    {
+        return 0;
+    }
+
+    double position = percentile * (samples.size() - 1);
+    uint_t index = (uint_t)position;
+
+    if (index + 1 >= samples.size())
+    {
+        return samples.back();
+    }
+
+    return samples[index] + (position - index) * (samples[index + 1] - samples[index]);
+}
+
+/*
+Returns percentile (between 0 and 1) of samples.
+*/
+double computePercentile(std::vector<double> samples, double percentile)
+{
+    std::sort(samples.begin(), samples.end());
+    return percentileSorted(samples, percentile);
+}
+
+/*
+Computes statistics of samples. Confidence interval of median is computed with percentile bootstrap: samples are
+resampled with replacement "numBootstrapSamples" times and interval is taken from the distribution of medians of
+resamples. Seed makes confidence interval reproducible.
+*/
+sample_statistics_t computeSampleStatistics(
+    std::vector<double> samples, uint_t numBootstrapSamples, double confidenceLevel, uint64_t seed
+)
+{
+    sample_statistics_t statistics = {};
+    statistics.numSamples = samples.size();
+
+    if (samples.empty())
+    {
+        return statistics;
+    }
+
+    std::sort(samples.begin(), samples.end());
+
+    double sum = 0;
+    for (uint_t i = 0; i < samples.size(); i++)
+    {
+        sum += samples[i];
+    }
+
+    statistics.min = samples.front();
+    statistics.max = samples.back();
+    statistics.mean = sum / samples.size();
+    statistics.median = percentileSorted(samples, 0.5);
+    statistics.percentile90 = percentileSorted(samples, 0.9);
+    statistics.percentile99 = percentileSorted(samples, 0.99);
+
+    std::vector<double> deviations(samples.size());
+    for (uint_t i = 0; i < samples.size(); i++)
+    {
+        deviations[i] = fabs(samples[i] - statistics.median);
+    }
+    statistics.mad = computePercentile(deviations, 0.5);
+
+    // Bootstrap distribution of medians
+    std::mt19937_64 generator(seed);
+    std::uniform_int_distribution<uint_t> distribution(0, samples.size() - 1);
+    std::vector<double> resample(samples.size());
+    std::vector<double> medians(numBootstrapSamples);
+
+    for (uint_t b = 0; b < numBootstrapSamples; b++)
+    {
+        for (uint_t i = 0; i < samples.size(); i++)
+        {
+            resample[i] = samples[distribution(generator)];
+        }
+
+        medians[b] = computePercentile(resample, 0.5);
+    }
+
+    std::sort(medians.begin(), medians.end());
+    statistics.confidenceLower = percentileSorted(medians, (1 - confidenceLevel) / 2);
+    statistics.confidenceUpper = percentileSorted(medians, (1 + confidenceLevel) / 2);
+
+    return statistics;
+}
+
+/*
+Mann-Whitney U test: returns two-sided p-value of hypothesis, that samples come from the same distribution.
+Doesn't assume normal distribution (times are usually skewed by outliers). Normal approximation with correction
+for ties is used, which is accurate for 8 or more samples in each group.
+*/
+double mannWhitneyPValue(std::vector<double> samples1, std::vector<double> samples2)
+{
+    double n1 = samples1.size(), n2 = samples2.size();
+
+    if (n1 == 0 || n2 == 0)
+    {
+        return 1;
+    }
+
+    // Pairs of sample and group, sorted by sample
+    std::vector<std::pair<double, uint_t>> pooled;
+    for (uint_t i = 0; i < samples1.size(); i++)
+    {
+        pooled.push_back(std::make_pair(samples1[i], 0));
+    }
+    for (uint_t i = 0; i < samples2.size(); i++)
+    {
+        pooled.push_back(std::make_pair(samples2[i], 1));
+    }
+    std::sort(pooled.begin(), pooled.end());
+
+    // Equal samples get average rank
+    double rankSum1 = 0, tieCorrection = 0;
+    for (uint_t start = 0; start < pooled.size(); )
+    {
+        uint_t end = start;
+        while (end < pooled.size() && pooled[end].first == pooled[start].first)
+        {
+            end++;
+        }
+
+        double rank = (start + 1 + end) / 2.0;
+        double numTies = end - start;
+        tieCorrection += numTies * numTies * numTies - numTies;
+
+        for (uint_t i = start; i < end; i++)
+        {
+            rankSum1 += pooled[i].second == 0 ? rank : 0;
+        }
+        start = end;
+    }
+
+    double n = n1 + n2;
+    double u = rankSum1 - n1 * (n1 + 1) / 2;
+    double mean = n1 * n2 / 2;
+    double variance = n1 * n2 / 12 * ((n + 1) - tieCorrection / (n * (n - 1)));
+
+    if (variance <= 0)
+    {
+        return 1;
+    }
+
+    // Continuity correction
+    double z = (fabs(u - mean) - 0.5) / sqrt(variance);
+    return (std::min)(1.0, erfc((std::max)(z, 0.0) / sqrt(2.0)));
+}
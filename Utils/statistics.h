@@ -0,0 +1,37 @@
+#ifndef STATISTICS_H
+#define STATISTICS_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "data_types_common.h"
+
+
+typedef struct SampleStatistics sample_statistics_t;
+
+/*
+Robust statistics of repeated measurements (sort times). Median and MAD (median absolute deviation) aren't
+affected by a few outliers (page faults, interrupts), as opposed to mean. Confidence interval of median is
+computed with bootstrap.
+*/
+struct SampleStatistics
+{
+    uint_t numSamples;
+    double min;
+    double max;
+    double mean;
+    double median;
+    double percentile90;
+    double percentile99;
+    double mad;
+    double confidenceLower;
+    double confidenceUpper;
+};
+
+double computePercentile(std::vector<double> samples, double percentile);
+sample_statistics_t computeSampleStatistics(
+    std::vector<double> samples, uint_t numBootstrapSamples, double confidenceLevel, uint64_t seed
+);
+double mannWhitneyPValue(std::vector<double> samples1, std::vector<double> samples2);
+
+#endif
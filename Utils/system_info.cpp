@@ -0,0 +1,123 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string>
+#include <fstream>
+#include <thread>
+
+#include "data_types_common.h"
+#include "system_info.h"
+
+// Compiler flags and git commit are provided by build system. Git commit is read from header, which is generated
+// on every build (see cmake/git_commit.cmake).
+#if defined(__has_include)
+#if __has_include("git_commit.h")
+#include "git_commit.h"
+#endif
+#endif
+#ifndef SORT_COMPILER_FLAGS
+#define SORT_COMPILER_FLAGS ""
+#endif
+#ifndef SORT_GIT_COMMIT
+#define SORT_GIT_COMMIT ""
+#endif
+
+
+/*
+Returns the name and version of compiler.
+*/
+static std::string getCompilerName()
+{
+#if defined(__clang__)
+    return std::string("Clang ") + __clang_version__;
+#elif defined(__GNUC__)
+    return std::string("GCC ") + __VERSION__;
+#elif defined(_MSC_VER)
+    return "MSVC " + std::to_string(_MSC_FULL_VER);
+#else
+    return "";
+#endif
+}
+
+#ifndef _WIN32
+
+/*
+Reads the value of "model name" from "/proc/cpuinfo".
+*/
+static std::string readCpuModel()
+{
+    std::ifstream file("/proc/cpuinfo");
+    std::string line;
+
+    while (std::getline(file, line))
+    {
+        if (line.compare(0, 10, "model name") == 0)
+        {
+            size_t start = line.find(':');
+            return start == std::string::npos ? "" : line.substr(line.find_first_not_of(' ', start + 1));
+        }
+    }
+
+    return "";
+}
+
+/*
+Reads the size of cache of CPU 0 with provided level and type ("Data" or "Unified") from sysfs. Returns 0, if
+cache doesn't exist.
+*/
+static uint64_t readCacheSize(uint_t level, std::string type)
+{
+    std::string folderCache = "/sys/devices/system/cpu/cpu0/cache/";
+
+    for (uint_t index = 0; ; index++)
+    {
+        std::string folderIndex = folderCache + "index" + std::to_string(index) + "/";
+        std::ifstream fileLevel(folderIndex + "level");
+        uint_t cacheLevel;
+
+        if (!(fileLevel >> cacheLevel))
+        {
+            return 0;
+        }
+
+        std::ifstream fileType(folderIndex + "type");
+        std::ifstream fileSize(folderIndex + "size");
+        std::string cacheType;
+        uint64_t size;
+        char unit = 'B';
+
+        fileType >> cacheType;
+        fileSize >> size >> unit;
+
+        if (cacheLevel == level && cacheType == type)
+        {
+            return size * (unit == 'K' ? 1024 : (unit == 'M' ? 1024 * 1024 : 1));
+        }
+    }
+}
+
+#endif
+
+/*
+Collects information about machine and build. Processor model and cache sizes are read only on Linux.
+*/
+system_info_t getSystemInfo()
+{
+    system_info_t info;
+
+    info.numCpus = std::thread::hardware_concurrency();
+    info.compiler = getCompilerName();
+    info.compilerFlags = SORT_COMPILER_FLAGS;
+    info.gitCommit = SORT_GIT_COMMIT;
+
+#ifndef _WIN32
+    info.cpuModel = readCpuModel();
+    info.cacheL1Data = readCacheSize(1, "Data");
+    info.cacheL2 = readCacheSize(2, "Unified");
+    info.cacheL3 = readCacheSize(3, "Unified");
+#else
+    info.cacheL1Data = info.cacheL2 = info.cacheL3 = 0;
+#endif
+
+    return info;
+}
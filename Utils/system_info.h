@@ -0,0 +1,31 @@
+#ifndef SYSTEM_INFO_H
+#define SYSTEM_INFO_H
+
+#include <stdint.h>
+#include <string>
+
+#include "data_types_common.h"
+
+
+typedef struct SystemInfo system_info_t;
+
+/*
+Description of machine and build, on which the benchmark was executed. It is saved together with results, so
+results from different machines or builds aren't compared by mistake. Unknown values are empty or 0.
+*/
+struct SystemInfo
+{
+    std::string cpuModel;
+    uint_t numCpus;
+    // Cache sizes in bytes
+    uint64_t cacheL1Data;
+    uint64_t cacheL2;
+    uint64_t cacheL3;
+    std::string compiler;
+    std::string compilerFlags;
+    std::string gitCommit;
+};
+
+system_info_t getSystemInfo();
+
+#endif
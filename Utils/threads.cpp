@@ -0,0 +1,176 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+#include "data_types_common.h"
+
+
+/*
+Pool of worker threads used by multithreaded CPU sorts. Threads are created only once and are reused by all
+subsequent calls of "parallelFor", so the cost of thread creation isn't included in sort timings.
+*/
+class ThreadPool
+{
+private:
+    std::vector<std::thread> _workers;
+    std::mutex _mutex;
+    std::condition_variable _conditionStart;
+    std::condition_variable _conditionEnd;
+    std::function<void(uint_t)> _function;
+    // Number of threads executing current function (including the calling thread)
+    uint_t _numThreadsActive = 0;
+    // Number of worker threads, which haven't finished current function yet
+    uint_t _numThreadsRemaining = 0;
+    // Incremented every time a new function is submitted to the pool
+    uint_t _generation = 0;
+    bool _stop = false;
+
+    /*
+    Main loop of worker thread. Worker with index "i" executes function with thread index "i + 1", because
+    thread index 0 is always executed by the thread, which called "run".
+    */
+    void workerLoop(uint_t workerIndex)
+    {
+        uint_t generation = 0;
+
+        while (true)
+        {
+            std::function<void(uint_t)> function;
+            bool isActive;
+
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _conditionStart.wait(lock, [&] { return _stop || _generation != generation; });
+
+                if (_stop)
+                {
+                    return;
+                }
+
+                generation = _generation;
+                isActive = workerIndex + 1 < _numThreadsActive;
+                function = _function;
+            }
+
+            if (!isActive)
+            {
+                continue;
+            }
+
+            function(workerIndex + 1);
+
+            std::unique_lock<std::mutex> lock(_mutex);
+            if (--_numThreadsRemaining == 0)
+            {
+                _conditionEnd.notify_one();
+            }
+        }
+    }
+
+public:
+    ~ThreadPool()
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+
+        _conditionStart.notify_all();
+        for (uint_t i = 0; i < _workers.size(); i++)
+        {
+            _workers[i].join();
+        }
+    }
+
+    /*
+    Executes function on provided number of threads and waits for all of them to finish.
+    */
+    void run(uint_t numThreads, std::function<void(uint_t)> function)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+
+            while (_workers.size() < numThreads - 1)
+            {
+                _workers.push_back(std::thread(&ThreadPool::workerLoop, this, (uint_t)_workers.size()));
+            }
+
+            _function = function;
+            _numThreadsActive = numThreads;
+            _numThreadsRemaining = numThreads - 1;
+            _generation++;
+        }
+
+        _conditionStart.notify_all();
+        function(0);
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        _conditionEnd.wait(lock, [&] { return _numThreadsRemaining == 0; });
+    }
+};
+
+// Number of threads used by multithreaded CPU sorts
+uint_t numThreadsGlobal = std::thread::hardware_concurrency() > 0 ? std::thread::hardware_concurrency() : 1;
+// Denotes if current thread is already executing function inside "parallelFor"
+thread_local bool isInsideParallelFor = false;
+
+
+/*
+Returns the number of threads used by multithreaded CPU sorts.
+*/
+uint_t getNumThreads()
+{
+    return numThreadsGlobal;
+}
+
+/*
+Sets the number of threads used by multithreaded CPU sorts.
+*/
+void setNumThreads(uint_t numThreads)
+{
+    if (numThreads == 0)
+    {
+        printf("Number of threads has to be greater than 0.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    numThreadsGlobal = numThreads;
+}
+
+/*
+Executes provided function on "numThreads" threads. Function receives the index of thread, which is executing it.
+Returns after all threads finish. If called from function already executed by "parallelFor", then all thread
+indexes are executed on current thread.
+*/
+void parallelFor(uint_t numThreads, std::function<void(uint_t threadIndex)> function)
+{
+    static ThreadPool threadPool;
+
+    if (numThreads <= 1 || isInsideParallelFor)
+    {
+        for (uint_t threadIndex = 0; threadIndex < numThreads; threadIndex++)
+        {
+            function(threadIndex);
+        }
+        return;
+    }
+
+    isInsideParallelFor = true;
+    threadPool.run(numThreads, [&](uint_t threadIndex) {
+        isInsideParallelFor = true;
+        function(threadIndex);
+    });
+    isInsideParallelFor = false;
+}
+
+/*
+Executes provided function on all threads used by multithreaded CPU sorts.
+*/
+void parallelFor(std::function<void(uint_t threadIndex)> function)
+{
+    parallelFor(getNumThreads(), function);
+}
@@ -0,0 +1,14 @@
+#ifndef THREADS_H
+#define THREADS_H
+
+#include <functional>
+
+#include "data_types_common.h"
+
+
+uint_t getNumThreads();
+void setNumThreads(uint_t numThreads);
+void parallelFor(uint_t numThreads, std::function<void(uint_t threadIndex)> function);
+void parallelFor(std::function<void(uint_t threadIndex)> function);
+
+#endif
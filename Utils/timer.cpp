@@ -0,0 +1,274 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string>
+#include <fstream>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#if !defined(_WIN32) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#include <cpuid.h>
+#define TIMER_TSC_SUPPORTED
+#endif
+
+#include "data_types_common.h"
+#include "constants_common.h"
+#include "timer.h"
+
+
+/*
+Source of timestamps. It is chosen only once, when timer is used for the first time:
+- Windows: QueryPerformanceCounter,
+- Linux on x86 with invariant TSC: time stamp counter, which frequency is calibrated with CLOCK_MONOTONIC_RAW,
+- otherwise: CLOCK_MONOTONIC_RAW in nanoseconds.
+*/
+class TimerSource
+{
+public:
+    const char *name;
+    // Number of timer ticks in one millisecond
+    double ticksPerMillisecond;
+    bool useTsc = false;
+
+    TimerSource()
+    {
+#ifdef _WIN32
+        LARGE_INTEGER frequency;
+        QueryPerformanceFrequency(&frequency);
+        name = "QueryPerformanceCounter";
+        ticksPerMillisecond = frequency.QuadPart / 1000.0;
+#else
+        name = "CLOCK_MONOTONIC_RAW";
+        ticksPerMillisecond = 1000000.0;
+
+#ifdef TIMER_TSC_SUPPORTED
+        if (TIMER_USE_TSC && isTscInvariant())
+        {
+            name = "invariant TSC";
+            ticksPerMillisecond = calibrateTsc();
+            useTsc = true;
+        }
+#endif
+#endif
+    }
+
+#ifndef _WIN32
+    /*
+    Returns time of CLOCK_MONOTONIC_RAW in nanoseconds.
+    */
+    static uint64_t getMonotonicTime()
+    {
+        struct timespec time;
+        clock_gettime(CLOCK_MONOTONIC_RAW, &time);
+        return (uint64_t)time.tv_sec * 1000000000ULL + time.tv_nsec;
+    }
+#endif
+
+#ifdef TIMER_TSC_SUPPORTED
+    /*
+    Reads time stamp counter. Fences prevent reordering of counter read with surrounding instructions.
+    */
+    static uint64_t readTsc()
+    {
+        _mm_lfence();
+        uint64_t ticks = __rdtsc();
+        _mm_lfence();
+        return ticks;
+    }
+
+    /*
+    Checks if time stamp counter runs at constant rate in all power states (CPUID leaf 0x80000007, EDX bit 8).
+    */
+    static bool isTscInvariant()
+    {
+        unsigned int eax, ebx, ecx, edx;
+
+        if (!__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) || eax < 0x80000007)
+        {
+            return false;
+        }
+
+        __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx);
+        return (edx & (1 << 8)) != 0;
+    }
+
+    /*
+    Measures the number of TSC ticks in one millisecond by comparing it with CLOCK_MONOTONIC_RAW.
+    */
+    static double calibrateTsc()
+    {
+        uint64_t timeStart = getMonotonicTime();
+        uint64_t ticksStart = readTsc();
+        uint64_t timeEnd, ticksEnd;
+
+        do
+        {
+            timeEnd = getMonotonicTime();
+            ticksEnd = readTsc();
+        } while (timeEnd - timeStart < TIMER_CALIBRATION_MS * 1000000ULL);
+
+        return (ticksEnd - ticksStart) * 1000000.0 / (timeEnd - timeStart);
+    }
+#endif
+
+    uint64_t getTicks()
+    {
+#ifdef _WIN32
+        LARGE_INTEGER ticks;
+        QueryPerformanceCounter(&ticks);
+        return ticks.QuadPart;
+#else
+#ifdef TIMER_TSC_SUPPORTED
+        if (useTsc)
+        {
+            return readTsc();
+        }
+#endif
+        return getMonotonicTime();
+#endif
+    }
+};
+
+/*
+Returns timer source. It is created (and calibrated) on the first call.
+*/
+TimerSource& getTimerSource()
+{
+    static TimerSource timerSource;
+    return timerSource;
+}
+
+
+/*
+Returns current timestamp in ticks of timer source.
+*/
+uint64_t getTimerTicks()
+{
+    return getTimerSource().getTicks();
+}
+
+/*
+Converts the number of timer ticks to milliseconds.
+*/
+double timerTicksToMilliseconds(uint64_t ticks)
+{
+    return ticks / getTimerSource().ticksPerMillisecond;
+}
+
+/*
+Returns the duration of one timer tick in nanoseconds.
+*/
+double getTimerResolution()
+{
+    return 1000000.0 / getTimerSource().ticksPerMillisecond;
+}
+
+/*
+Returns the name of timer source.
+*/
+const char* getTimerSourceName()
+{
+    return getTimerSource().name;
+}
+
+/*
+Starts the stopwatch (remembers the current time).
+*/
+void startStopwatch(stopwatch_t *start)
+{
+    // Timer source is created before the start is read, so calibration isn't timed.
+    getTimerSource();
+    *start = getTimerTicks();
+}
+
+/*
+Ends the stopwatch (calculates the difference between current time and parameter "start") and returns time
+in milliseconds. Also prints out comment.
+*/
+double endStopwatch(stopwatch_t start, char* comment)
+{
+    stopwatch_t end = getTimerTicks();
+    double elapsedTime = timerTicksToMilliseconds(end - start);
+
+    if (comment != NULL)
+    {
+        printf("%s: %.5lf ms\n", comment, elapsedTime);
+    }
+
+    return elapsedTime;
+}
+
+/*
+Ends the stopwatch (calculates the difference between current time and parameter "start") and returns time
+in milliseconds.
+*/
+double endStopwatch(stopwatch_t start)
+{
+    return endStopwatch(start, NULL);
+}
+
+/*
+Pins the calling thread to provided CPU, so it isn't migrated between cores during timing. Returns false, if
+pinning failed.
+*/
+bool pinThreadToCpu(uint_t cpuIndex)
+{
+#ifdef _WIN32
+    return SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << cpuIndex) != 0;
+#else
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(cpuIndex, &cpuSet);
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) == 0;
+#endif
+}
+
+/*
+Reads the first word of file. Returns empty string, if file doesn't exist.
+*/
+static std::string readFirstWord(std::string filePath)
+{
+    std::ifstream file(filePath);
+    std::string word;
+
+    file >> word;
+    return word;
+}
+
+/*
+Prints warnings, if CPU frequency can change during the benchmark (frequency scaling governor isn't set to
+"performance" or turbo boost is enabled). In that case sort times are less reproducible. Checked only on Linux.
+*/
+void printFrequencyScalingWarnings()
+{
+#ifndef _WIN32
+    std::string folderCpu = "/sys/devices/system/cpu/";
+    uint_t numCpus = std::thread::hardware_concurrency();
+
+    for (uint_t cpu = 0; cpu < numCpus; cpu++)
+    {
+        std::string governor = readFirstWord(folderCpu + "cpu" + std::to_string(cpu) + "/cpufreq/scaling_governor");
+
+        if (!governor.empty() && governor != "performance")
+        {
+            printf(
+                "> WARNING: frequency scaling governor of CPU %u is '%s' (not 'performance').\n", cpu,
+                governor.c_str()
+            );
+            break;
+        }
+    }
+
+    if (readFirstWord(folderCpu + "intel_pstate/no_turbo") == "0" || readFirstWord(folderCpu + "cpufreq/boost") == "1")
+    {
+        printf("> WARNING: turbo boost is enabled.\n");
+    }
+#endif
+}
@@ -0,0 +1,22 @@
+#ifndef TIMER_H
+#define TIMER_H
+
+#include <stdint.h>
+
+#include "data_types_common.h"
+
+
+// Timestamp in ticks of timer source (see "getTimerSourceName")
+typedef uint64_t stopwatch_t;
+
+uint64_t getTimerTicks();
+double timerTicksToMilliseconds(uint64_t ticks);
+double getTimerResolution();
+const char* getTimerSourceName();
+void startStopwatch(stopwatch_t *start);
+double endStopwatch(stopwatch_t start, char* comment);
+double endStopwatch(stopwatch_t start);
+bool pinThreadToCpu(uint_t cpuIndex);
+void printFrequencyScalingWarnings();
+
+#endif
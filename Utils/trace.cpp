@@ -0,0 +1,142 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <algorithm>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "data_types_common.h"
+#include "timer.h"
+#include "trace.h"
+
+
+/*
+Phase of sort measured by "TraceScope".
+*/
+struct TraceEvent
+{
+    const char *name;
+    const char *argName;
+    int64_t argValue;
+    uint64_t start;
+    uint64_t end;
+};
+
+/*
+Timeline of one thread. Every thread appends only to its own timeline, so no locking is needed while sorting.
+*/
+struct TraceTimeline
+{
+    uint_t threadId;
+    std::vector<TraceEvent> events;
+};
+
+// Timelines of all threads, which recorded at least one event. Timelines are never freed, because worker
+// threads can outlive the code, which writes the trace.
+std::vector<std::unique_ptr<TraceTimeline>> traceTimelines;
+std::mutex traceTimelinesMutex;
+// Timeline of current thread
+thread_local TraceTimeline *traceTimelineThread = NULL;
+
+
+/*
+Returns timeline of calling thread. Timeline is created on the first call in every thread.
+*/
+static TraceTimeline* getTraceTimeline()
+{
+    if (traceTimelineThread == NULL)
+    {
+        std::lock_guard<std::mutex> lock(traceTimelinesMutex);
+
+        traceTimelines.push_back(std::unique_ptr<TraceTimeline>(new TraceTimeline()));
+        traceTimelineThread = traceTimelines.back().get();
+        traceTimelineThread->threadId = traceTimelines.size() - 1;
+    }
+
+    return traceTimelineThread;
+}
+
+/*
+Adds event to timeline of calling thread. Start and end are in timer ticks.
+*/
+void traceAddEvent(const char *name, const char *argName, int64_t argValue, uint64_t start, uint64_t end)
+{
+    TraceEvent event = { name, argName, argValue, start, end };
+    getTraceTimeline()->events.push_back(event);
+}
+
+/*
+Writes events of all threads to file in Chrome trace event format (can be opened in chrome://tracing or
+Perfetto) and clears them. Must not be called while sort is being executed.
+*/
+void writeTraceToFile(std::string filePath)
+{
+    std::lock_guard<std::mutex> lock(traceTimelinesMutex);
+
+    // Timestamps are written in microseconds relative to the first event
+    uint64_t timeBase = UINT64_MAX;
+    for (uint_t i = 0; i < traceTimelines.size(); i++)
+    {
+        for (uint_t j = 0; j < traceTimelines[i]->events.size(); j++)
+        {
+            timeBase = (std::min)(timeBase, traceTimelines[i]->events[j].start);
+        }
+    }
+
+    FILE *file = fopen(filePath.c_str(), "w");
+    if (file == NULL)
+    {
+        printf("Trace file '%s' couldn't be opened.\n", filePath.c_str());
+        return;
+    }
+
+    fprintf(file, "{\"traceEvents\":[");
+    const char *separator = "\n";
+
+    for (uint_t i = 0; i < traceTimelines.size(); i++)
+    {
+        TraceTimeline *timeline = traceTimelines[i].get();
+
+        fprintf(
+            file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":\"thread %u\"}}",
+            separator, timeline->threadId, timeline->threadId
+        );
+        separator = ",\n";
+
+        for (uint_t j = 0; j < timeline->events.size(); j++)
+        {
+            TraceEvent *event = &timeline->events[j];
+
+            fprintf(
+                file, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3lf,\"dur\":%.3lf", event->name,
+                timeline->threadId, timerTicksToMilliseconds(event->start - timeBase) * 1000,
+                timerTicksToMilliseconds(event->end - event->start) * 1000
+            );
+            if (event->argName != NULL)
+            {
+                fprintf(file, ",\"args\":{\"%s\":%lld}", event->argName, (long long)event->argValue);
+            }
+            fprintf(file, "}");
+        }
+
+        timeline->events.clear();
+    }
+
+    fprintf(file, "\n]}\n");
+    fclose(file);
+}
+
+/*
+Removes all recorded events.
+*/
+void clearTrace()
+{
+    std::lock_guard<std::mutex> lock(traceTimelinesMutex);
+
+    for (uint_t i = 0; i < traceTimelines.size(); i++)
+    {
+        traceTimelines[i]->events.clear();
+    }
+}
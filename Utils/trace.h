@@ -0,0 +1,73 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+#include <string>
+
+#include "data_types_common.h"
+#include "constants_common.h"
+#include "timer.h"
+
+
+/*
+Records the duration of scope (phase of sort) into timeline of current thread. Name has to be a string literal,
+because only the pointer is stored. Phases, which are executed on subarrays (recursion, small sorts), are traced
+with TRACE_SCOPE_SIZED only if subarray has at least TRACE_MIN_LENGTH elements, so small subarrays don't flood the
+trace. If TRACE_ENABLED is 0, macros are empty and phases aren't measured at all.
+Usage:
+    TRACE_SCOPE("radix histogram");
+    TRACE_SCOPE_ARG("radix pass", "bit offset", bitOffset);
+    TRACE_SCOPE_SIZED("quicksort partition", "length", arrayLength, arrayLength);
+*/
+#if TRACE_ENABLED
+#define TRACE_CONCAT_INNER(a, b) a ## b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(name) TraceScope TRACE_CONCAT(traceScope, __LINE__)(name, NULL, 0, true)
+#define TRACE_SCOPE_ARG(name, argName, argValue) \
+    TraceScope TRACE_CONCAT(traceScope, __LINE__)(name, argName, (int64_t)(argValue), true)
+#define TRACE_SCOPE_SIZED(name, argName, argValue, length) \
+    TraceScope TRACE_CONCAT(traceScope, __LINE__)(name, argName, (int64_t)(argValue), (length) >= TRACE_MIN_LENGTH)
+#else
+#define TRACE_SCOPE(name)
+#define TRACE_SCOPE_ARG(name, argName, argValue)
+#define TRACE_SCOPE_SIZED(name, argName, argValue, length)
+#endif
+
+
+void traceAddEvent(const char *name, const char *argName, int64_t argValue, uint64_t start, uint64_t end);
+void writeTraceToFile(std::string filePath);
+void clearTrace();
+
+/*
+Measures the time from construction until the end of scope and adds it to timeline of current thread. If
+"isEnabled" is false, nothing is measured.
+*/
+class TraceScope
+{
+private:
+    const char *_name;
+    const char *_argName;
+    int64_t _argValue;
+    uint64_t _start;
+    bool _isEnabled;
+
+public:
+    TraceScope(const char *name, const char *argName, int64_t argValue, bool isEnabled)
+    {
+        _name = name;
+        _argName = argName;
+        _argValue = argValue;
+        _isEnabled = isEnabled;
+        _start = isEnabled ? getTimerTicks() : 0;
+    }
+
+    ~TraceScope()
+    {
+        if (_isEnabled)
+        {
+            traceAddEvent(_name, _argName, _argValue, _start, getTimerTicks());
+        }
+    }
+};
+
+#endif
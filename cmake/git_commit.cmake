@@ -0,0 +1,18 @@
+# Writes header with git commit of source tree ("git describe --always --dirty"). It is executed on every build, so
+# results are never stamped with the commit from the time CMake was configured. Header is rewritten only if the
+# commit changed, so unchanged tree doesn't cause recompilation.
+execute_process(
+    COMMAND git describe --always --dirty
+    WORKING_DIRECTORY ${SOURCE_DIR}
+    OUTPUT_VARIABLE SORT_GIT_COMMIT
+    OUTPUT_STRIP_TRAILING_WHITESPACE
+    ERROR_QUIET
+)
+
+set(SORT_GIT_COMMIT_HEADER "#define SORT_GIT_COMMIT \"${SORT_GIT_COMMIT}\"\n")
+if(EXISTS ${OUTPUT_FILE})
+    file(READ ${OUTPUT_FILE} SORT_GIT_COMMIT_HEADER_OLD)
+endif()
+if(NOT SORT_GIT_COMMIT_HEADER STREQUAL SORT_GIT_COMMIT_HEADER_OLD)
+    file(WRITE ${OUTPUT_FILE} "${SORT_GIT_COMMIT_HEADER}")
+endif()